@@ -6,6 +6,7 @@
  * @note:  I got this code from: https://github.com/mvorbrodt/blog/blob/master/src/queue.hpp
  *         Thanks to Vorbrodt for such an easy and clean implementation.
  */
+#pragma once
 
 // C++ Libraries
 #include <mutex>
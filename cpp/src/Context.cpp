@@ -0,0 +1,64 @@
+/**
+ * @file    Context.cpp
+ * @author  Marvin Smith
+ * @date    12/22/2020
+*/
+#include "Context.hpp"
+
+/****************************************/
+/*          Build the Context           */
+/****************************************/
+Context::ptr_t Context::Create( const std::vector<DB_Point>& point_list,
+                                const Point&                 start_point,
+                                const Point&                 end_point,
+                                bool                         snap_endpoints )
+{
+    auto context = std::make_shared<Context>();
+    context->start_point = start_point;
+    context->end_point   = end_point;
+
+    context->geo_point_list.reserve( point_list.size() );
+    context->x_list.reserve( point_list.size() );
+    context->y_list.reserve( point_list.size() );
+    for( const auto& pt : point_list )
+    {
+        context->geo_point_list.push_back( ToPoint2D( pt.x_norm, pt.y_norm ) );
+        context->x_list.push_back( pt.x_norm );
+        context->y_list.push_back( pt.y_norm );
+    }
+
+    // Bulk-load the spatial index over everything the sector covers, endpoints included
+    if( !context->geo_point_list.empty() )
+    {
+        auto min_corner = Point::Min( start_point, end_point );
+        auto max_corner = Point::Max( start_point, end_point );
+        for( const auto& pt : context->geo_point_list )
+        {
+            min_corner = Point::Min( min_corner, pt );
+            max_corner = Point::Max( max_corner, pt );
+        }
+        context->point_tree = Flat_QuadTree( Rect( min_corner - ToPoint2D( 1, 1 ), max_corner + ToPoint2D( 1, 1 ) ),
+                                             POINT_TREE_MAX_OBJECTS,
+                                             POINT_TREE_MAX_LEVELS );
+        context->point_tree.Build( context->geo_point_list );
+    }
+
+    if( snap_endpoints )
+    {
+        context->start_point = context->Snap_To_Track( start_point );
+        context->end_point   = context->Snap_To_Track( end_point );
+    }
+    return context;
+}
+
+/****************************************************/
+/*          Snap a Location to the Track            */
+/****************************************************/
+Point Context::Snap_To_Track( const Point& point ) const
+{
+    if( point_tree.Size() == 0 )
+    {
+        return point;
+    }
+    return geo_point_list[point_tree.Nearest( point )];
+}
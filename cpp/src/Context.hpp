@@ -6,19 +6,57 @@
 #pragma once
 
 // C++ Libraries
+#include <memory>
 #include <vector>
 
 // Project Libraries
 #include "DB_Point.hpp"
 #include "Geometry.hpp"
 
+/**
+ * @class Context
+ * @brief Read-only sector data shared by every fitness evaluation.
+ *
+ * Built once per sector and handed to all GA workers by reference.  Only
+ * the compact data needed to score a phenotype is kept here.
+ */
 struct Context
 {
-    // Reference Point List
-    std::vector<DB_Point> point_list;
+    /// Pointer Type
+    typedef std::shared_ptr<const Context> ptr_t;
+
+    /// Leaf size and depth of the point index
+    static constexpr size_t POINT_TREE_MAX_OBJECTS = 20;
+    static constexpr size_t POINT_TREE_MAX_LEVELS  = 10;
+
+    /**
+     * @brief Build the Context from the normalized sector points
+     * @param point_list Sector points (Normalize_Points must already be applied)
+     * @param start_point Normalized starting coordinate
+     * @param end_point Normalized ending coordinate
+     * @param snap_endpoints Move the start and end points onto the nearest reference point
+     */
+    static ptr_t Create( const std::vector<DB_Point>& point_list,
+                         const Point&                 start_point,
+                         const Point&                 end_point,
+                         bool                         snap_endpoints = false );
+
+    /**
+     * @brief Get the reference point closest to a location (The location itself if there are none)
+     */
+    Point Snap_To_Track( const Point& point ) const;
+
+    // Reference Point List (Normalized Coordinates)
     std::vector<Point> geo_point_list;
 
+    // Reference Point Coordinates in Structure-of-Arrays form for the distance kernels
+    std::vector<double> x_list;
+    std::vector<double> y_list;
+
+    // Spatial index over the reference points (Ids are indices into geo_point_list)
+    Flat_QuadTree point_tree;
+
     Point start_point;
     Point end_point;
 
-}; // End of Context Class
\ No newline at end of file
+}; // End of Context Class
@@ -0,0 +1,132 @@
+/**
+ * @file    Cost_Model.cpp
+ * @author  Marvin Smith
+ * @date    1/13/2021
+ */
+#include "Cost_Model.hpp"
+
+// Project Libraries
+#include "Fitness_Engine.hpp"
+
+/****************************************************/
+/*          Scale Prices to Match Observed Time     */
+/****************************************************/
+static Cost_Model::Prices Scale_Prices( Cost_Model::Prices prices,
+                                        double             actual_sec,
+                                        double             predicted_sec )
+{
+    if( actual_sec > 0 && predicted_sec > 0 )
+    {
+        prices.seconds_per_point   *= actual_sec / predicted_sec;
+        prices.seconds_per_segment *= actual_sec / predicted_sec;
+    }
+    return prices;
+}
+
+/********************************/
+/*          Constructor         */
+/********************************/
+Cost_Model::Cost_Model( const Stats_Aggregator& aggregator,
+                        const Prices&           scan_prices,
+                        const Prices&           cull_prices )
+  : m_aggregator( aggregator ),
+    m_scan_prices( scan_prices ),
+    m_cull_prices( cull_prices )
+{
+}
+
+/****************************************/
+/*          Size of a GA Job            */
+/****************************************/
+Cost_Model::Job_Size Cost_Model::Work_Units( size_t number_points,
+                                             size_t number_waypoints,
+                                             size_t population_size,
+                                             size_t number_iterations )
+{
+    // Segments = waypoints + 1, since the start and end points are fixed
+    Job_Size job_size;
+    job_size.number_segments = number_waypoints + 1;
+    job_size.point_units     = (double)number_points * population_size * number_iterations;
+    job_size.segment_units   = job_size.point_units * job_size.number_segments;
+    return job_size;
+}
+
+/****************************************/
+/*          Predict the Run Time        */
+/****************************************/
+double Cost_Model::Predict_Seconds( const Job_Size& job_size ) const
+{
+    auto prices = Get_Prices( job_size.number_segments );
+    return job_size.point_units * prices.seconds_per_point +
+           job_size.segment_units * prices.seconds_per_segment;
+}
+
+/********************************************/
+/*          Get the Current Prices          */
+/********************************************/
+Cost_Model::Prices Cost_Model::Get_Prices( size_t number_segments ) const
+{
+    const bool culled = Fitness_Engine::Uses_Culling( number_segments );
+    const auto& prior = culled ? m_cull_prices : m_scan_prices;
+
+    // Only jobs of the same kind say anything about the split between the terms
+    auto jobs = m_aggregator.Get_Job_Costs();
+    std::vector<Stats_Aggregator::Job_Cost> same_kind;
+    double actual_sec = 0;
+    double prior_sec  = 0;
+    for( const auto& job : jobs )
+    {
+        const bool job_culled = Fitness_Engine::Uses_Culling( job.number_segments );
+        if( job_culled == culled )
+        {
+            same_kind.push_back( job );
+        }
+        const auto& job_prior = job_culled ? m_cull_prices : m_scan_prices;
+        actual_sec += job.actual_sec;
+        prior_sec  += job.point_units * job_prior.seconds_per_point + job.segment_units * job_prior.seconds_per_segment;
+    }
+    if( !same_kind.empty() )
+    {
+        return Fit_Prices( same_kind, prior );
+    }
+
+    // Nothing of this kind yet, so only correct for the speed of the machine
+    return Scale_Prices( prior, actual_sec, prior_sec );
+}
+
+/****************************************************/
+/*          Fit the Prices to Reported Jobs         */
+/****************************************************/
+Cost_Model::Prices Cost_Model::Fit_Prices( const std::vector<Stats_Aggregator::Job_Cost>& jobs,
+                                           const Prices&                                   prior )
+{
+    // Least squares through the origin: actual = point_units * a + segment_units * b
+    double pp = 0, ps = 0, ss = 0, pt = 0, st = 0;
+    double actual_sec = 0, prior_sec = 0;
+    for( const auto& job : jobs )
+    {
+        pp += job.point_units * job.point_units;
+        ps += job.point_units * job.segment_units;
+        ss += job.segment_units * job.segment_units;
+        pt += job.point_units * job.actual_sec;
+        st += job.segment_units * job.actual_sec;
+        actual_sec += job.actual_sec;
+        prior_sec  += job.point_units * prior.seconds_per_point + job.segment_units * prior.seconds_per_segment;
+    }
+
+    // Needs at least two route lengths, and both prices have to come out positive
+    const double det = pp * ss - ps * ps;
+    if( det > 1e-9 * pp * ss )
+    {
+        Prices prices;
+        prices.seconds_per_point   = ( pt * ss - st * ps ) / det;
+        prices.seconds_per_segment = ( pp * st - ps * pt ) / det;
+        if( prices.seconds_per_point > 0 && prices.seconds_per_segment > 0 )
+        {
+            return prices;
+        }
+    }
+
+    // Otherwise keep the prior split and match the total
+    return Scale_Prices( prior, actual_sec, prior_sec );
+}
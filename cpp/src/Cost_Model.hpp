@@ -0,0 +1,119 @@
+/**
+ * @file    Cost_Model.hpp
+ * @author  Marvin Smith
+ * @date    1/13/2021
+ */
+#pragma once
+
+// C++ Libraries
+#include <cstddef>
+#include <vector>
+
+// Project Libraries
+#include "Stats_Aggregator.hpp"
+
+/**
+ * @class Cost_Model
+ * @brief Predicts the run time of a (sector, waypoint-count) GA job.
+ *
+ * The fitness pass dominates, and it has two parts per population member per
+ * generation: per-point work (the accumulation, and the few segments left near
+ * each point) and per-point, per-segment work (the distance tests).  The two are
+ * priced separately, so the model can tell a big sector with a short route from
+ * a small sector with a long one.
+ *
+ * Culled routes (See Fitness_Engine::Uses_Culling) spend far less per segment and
+ * more per point, so they get their own pair of prices.  Both pairs start from a
+ * prior and are refit by least squares over the jobs already reported to the
+ * Stats_Aggregator.
+ *
+ * Jobs are reported with the generations they actually ran, so runs that hit
+ * their Exit_Condition early do not drag the prices down.  A prediction has to
+ * assume the full max_iterations, so it is an upper bound for such runs.
+ */
+class Cost_Model
+{
+    public:
+
+        /**
+         * @brief Size of a GA job, one term per price
+         */
+        struct Job_Size
+        {
+            /// Segments per route
+            size_t number_segments { 0 };
+
+            /// Points scored over the whole run
+            double point_units { 0 };
+
+            /// Point-segment pairs scored over the whole run
+            double segment_units { 0 };
+        };
+
+        /**
+         * @brief Seconds per point unit and per segment unit
+         */
+        struct Prices
+        {
+            double seconds_per_point;
+            double seconds_per_segment;
+        };
+
+        /// Prior for routes scanned in full.  Fit to single-thread GA runs on the sector_2 and
+        /// sector_5 test data (200 members, 100 generations, 2 to 10 waypoints).
+        static constexpr Prices DEFAULT_SCAN_PRICES { 6.1e-9, 7.2e-10 };
+
+        /// Prior for culled routes, from the same runs (11 to 40 waypoints)
+        static constexpr Prices DEFAULT_CULL_PRICES { 1.5e-8, 1.8e-10 };
+
+        /**
+         * @brief Constructor
+         * @param aggregator Source of the observed job timings
+         * @param scan_prices Prices for routes scanned in full, used until jobs have been reported
+         * @param cull_prices Prices for culled routes, used until jobs have been reported
+         */
+        explicit Cost_Model( const Stats_Aggregator& aggregator,
+                             const Prices&           scan_prices = DEFAULT_SCAN_PRICES,
+                             const Prices&           cull_prices = DEFAULT_CULL_PRICES );
+
+        /**
+         * @brief Size of a GA job
+         * @param number_iterations Generations run (max_iterations for a prediction)
+         */
+        static Job_Size Work_Units( size_t number_points,
+                                    size_t number_waypoints,
+                                    size_t population_size,
+                                    size_t number_iterations );
+
+        /**
+         * @brief Predict the run time of a job
+         */
+        double Predict_Seconds( const Job_Size& job_size ) const;
+
+        /**
+         * @brief Get the current prices for routes with this many segments
+         *
+         * Fit to the reported jobs of the same kind (culled or not).  With a single
+         * route length among them the two terms cannot be told apart, so the prior
+         * is only scaled to match.  Without any, the prior is scaled to match all
+         * reported jobs, which still picks up the speed of the machine.
+         */
+        Prices Get_Prices( size_t number_segments ) const;
+
+    private:
+
+        /**
+         * @brief Fit prices to reported jobs, starting from a prior
+         * @param prior Prices to scale if the jobs cannot separate the terms
+         */
+        static Prices Fit_Prices( const std::vector<Stats_Aggregator::Job_Cost>& jobs,
+                                  const Prices&                                   prior );
+
+        /// Timing Source
+        const Stats_Aggregator& m_aggregator;
+
+        /// Prices used before any job has been reported
+        Prices m_scan_prices;
+        Prices m_cull_prices;
+
+}; // End of Cost_Model Class
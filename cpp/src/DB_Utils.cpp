@@ -137,6 +137,19 @@ static int point_callback( void *data, int argc, char **argv, char **azColName )
     return 0;
 }
 
+/************************************/
+/*          Callback Worker         */
+/************************************/
+static int point_count_callback( void *data, int argc, char **argv, char ** /*azColName*/ )
+{
+    auto point_counts = reinterpret_cast<std::map<std::string,size_t>*>( data );
+    if( argc == 2 && argv[0] && argv[1] )
+    {
+        (*point_counts)[argv[0]] = std::stoul( argv[1] );
+    }
+    return 0;
+}
+
 /****************************************/
 /*          Open the Database           */
 /****************************************/
@@ -204,6 +217,27 @@ std::map<std::string,std::tuple<DB_Point,DB_Point>>  Load_Sector_Data( sqlite3 *
     return sector_data;
 }
 
+/************************************************/
+/*          Count the Points per Sector         */
+/************************************************/
+std::map<std::string,size_t> Load_Sector_Point_Counts( sqlite3* db )
+{
+    std::lock_guard<std::mutex> lck(db_mtx);
+    std::string sql = "SELECT sectorId, COUNT(*) FROM point_list GROUP BY sectorId";
+    char* zErrMsg = 0;
+
+    std::map<std::string,size_t> point_counts;
+    auto rc = sqlite3_exec( db, sql.c_str(), point_count_callback, &point_counts, &zErrMsg );
+
+    // Check Errors 
+    if( rc != SQLITE_OK )
+    {
+        BOOST_LOG_TRIVIAL(error) << "Point-Count SQL Error: " << zErrMsg;
+        sqlite3_free( zErrMsg );
+    }
+    return point_counts;
+}
+
 /****************************************/
 /*          Loading Point List          */
 /****************************************/
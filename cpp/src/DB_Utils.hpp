@@ -27,6 +27,11 @@ sqlite3* Open_Database( const std::filesystem::path& db_path );
  */
 std::map<std::string,std::tuple<DB_Point,DB_Point>>  Load_Sector_Data( sqlite3 *db );
 
+/**
+ * @brief Count the points in each sector without loading them
+ */
+std::map<std::string,size_t> Load_Sector_Point_Counts( sqlite3* db );
+
 /**
  * @brief Load the Point List
  */
@@ -0,0 +1,418 @@
+/**
+ * @file    Distance_Kernels.cpp
+ * @author  Marvin Smith
+ * @date    1/10/2021
+ *
+ * @note This file must be built with -ffp-contract=off so the compiler does not
+ *       fuse multiply/add pairs differently in each kernel.
+ */
+#include "Distance_Kernels.hpp"
+
+// C++ Libraries
+#include <limits>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define ROUTE_FINDER_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+/************************************************/
+/*          Resize the Segment Columns          */
+/************************************************/
+void Segment_Table::Resize( size_t number_segments )
+{
+    origin_x.resize( number_segments );
+    origin_y.resize( number_segments );
+    terminus_x.resize( number_segments );
+    terminus_y.resize( number_segments );
+    direction_x.resize( number_segments );
+    direction_y.resize( number_segments );
+    inv_length2.resize( number_segments );
+}
+
+/************************************************/
+/*          Print the Instruction Set           */
+/************************************************/
+std::string To_String( Instruction_Set isa )
+{
+    switch( isa )
+    {
+        case Instruction_Set::SCALAR:
+            return "SCALAR";
+        case Instruction_Set::SSE2:
+            return "SSE2";
+        case Instruction_Set::AVX2:
+            return "AVX2";
+        case Instruction_Set::AVX512:
+            return "AVX512";
+    }
+    return "UNKNOWN";
+}
+
+/************************************************/
+/*          Distance to One Segment             */
+/************************************************/
+double Segment_Distance2( const Segment_Table& segments,
+                          size_t               seg_idx,
+                          double               px,
+                          double               py )
+{
+    const double dx = px - segments.origin_x[seg_idx];
+    const double dy = py - segments.origin_y[seg_idx];
+    const double t  = (dx * segments.direction_x[seg_idx] + dy * segments.direction_y[seg_idx]) * segments.inv_length2[seg_idx];
+
+    // Before the start of the segment (or degenerate segment)
+    if( t <= 0 || segments.inv_length2[seg_idx] <= 0 )
+    {
+        return dx*dx + dy*dy;
+    }
+
+    // After the end of the segment
+    if( t >= 1 )
+    {
+        const double ex = px - segments.terminus_x[seg_idx];
+        const double ey = py - segments.terminus_y[seg_idx];
+        return ex*ex + ey*ey;
+    }
+
+    const double cross = segments.direction_x[seg_idx] * dy - dx * segments.direction_y[seg_idx];
+    return cross * cross * segments.inv_length2[seg_idx];
+}
+
+/************************************************/
+/*          Scalar Reference Kernel             */
+/************************************************/
+static void Nearest_Segment_Scalar( const double*        xs,
+                                    const double*        ys,
+                                    size_t               start_idx,
+                                    size_t               number_points,
+                                    const Segment_Table& segments,
+                                    double*              distances2,
+                                    uint32_t*            segment_ids )
+{
+    const size_t number_segments = segments.Size();
+    for( size_t i=start_idx; i<number_points; i++ )
+    {
+        double   best     = std::numeric_limits<double>::infinity();
+        uint32_t best_seg = 0;
+        for( size_t seg_idx=0; seg_idx<number_segments; seg_idx++ )
+        {
+            const double dist = Segment_Distance2( segments, seg_idx, xs[i], ys[i] );
+            if( dist < best )
+            {
+                best     = dist;
+                best_seg = seg_idx;
+            }
+        }
+        distances2[i]  = best;
+        segment_ids[i] = best_seg;
+    }
+}
+
+#ifdef ROUTE_FINDER_X86_KERNELS
+
+/************************************************/
+/*          SSE2 Kernel (2 Points/Pass)         */
+/************************************************/
+static inline __m128d Select_SSE2( __m128d mask,
+                                   __m128d if_true,
+                                   __m128d if_false )
+{
+    return _mm_or_pd( _mm_and_pd( mask, if_true ),
+                      _mm_andnot_pd( mask, if_false ) );
+}
+
+static void Nearest_Segment_SSE2( const double*        xs,
+                                  const double*        ys,
+                                  size_t               number_points,
+                                  const Segment_Table& segments,
+                                  double*              distances2,
+                                  uint32_t*            segment_ids )
+{
+    const size_t  number_segments = segments.Size();
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d one  = _mm_set1_pd( 1.0 );
+
+    size_t i = 0;
+    for( ; i + 2 <= number_points; i += 2 )
+    {
+        const __m128d px = _mm_loadu_pd( xs + i );
+        const __m128d py = _mm_loadu_pd( ys + i );
+        __m128d best     = _mm_set1_pd( std::numeric_limits<double>::infinity() );
+        __m128d best_seg = zero;
+
+        for( size_t s=0; s<number_segments; s++ )
+        {
+            const __m128d dir_x = _mm_set1_pd( segments.direction_x[s] );
+            const __m128d dir_y = _mm_set1_pd( segments.direction_y[s] );
+            const __m128d inv   = _mm_set1_pd( segments.inv_length2[s] );
+
+            const __m128d dx = _mm_sub_pd( px, _mm_set1_pd( segments.origin_x[s] ) );
+            const __m128d dy = _mm_sub_pd( py, _mm_set1_pd( segments.origin_y[s] ) );
+            const __m128d t  = _mm_mul_pd( _mm_add_pd( _mm_mul_pd( dx, dir_x ), _mm_mul_pd( dy, dir_y ) ), inv );
+
+            const __m128d ex = _mm_sub_pd( px, _mm_set1_pd( segments.terminus_x[s] ) );
+            const __m128d ey = _mm_sub_pd( py, _mm_set1_pd( segments.terminus_y[s] ) );
+
+            const __m128d d_start = _mm_add_pd( _mm_mul_pd( dx, dx ), _mm_mul_pd( dy, dy ) );
+            const __m128d d_end   = _mm_add_pd( _mm_mul_pd( ex, ex ), _mm_mul_pd( ey, ey ) );
+            const __m128d cross   = _mm_sub_pd( _mm_mul_pd( dir_x, dy ), _mm_mul_pd( dx, dir_y ) );
+            const __m128d d_perp  = _mm_mul_pd( _mm_mul_pd( cross, cross ), inv );
+
+            const __m128d use_start = _mm_or_pd( _mm_cmple_pd( t, zero ), _mm_cmple_pd( inv, zero ) );
+            const __m128d use_end   = _mm_cmpge_pd( t, one );
+
+            __m128d dist = Select_SSE2( use_end, d_end, d_perp );
+            dist = Select_SSE2( use_start, d_start, dist );
+
+            const __m128d closer = _mm_cmplt_pd( dist, best );
+            best     = Select_SSE2( closer, dist, best );
+            best_seg = Select_SSE2( closer, _mm_set1_pd( (double)s ), best_seg );
+        }
+
+        _mm_storeu_pd( distances2 + i, best );
+        double seg_ids[2];
+        _mm_storeu_pd( seg_ids, best_seg );
+        segment_ids[i]   = (uint32_t)seg_ids[0];
+        segment_ids[i+1] = (uint32_t)seg_ids[1];
+    }
+
+    // Remainder (Only call out when there is one, leaving the vector code is not free)
+    if( i < number_points )
+    {
+        Nearest_Segment_Scalar( xs, ys, i, number_points, segments, distances2, segment_ids );
+    }
+}
+
+/************************************************/
+/*          AVX2 Kernel (4 Points/Pass)         */
+/************************************************/
+__attribute__((target("avx2")))
+static void Nearest_Segment_AVX2( const double*        xs,
+                                  const double*        ys,
+                                  size_t               number_points,
+                                  const Segment_Table& segments,
+                                  double*              distances2,
+                                  uint32_t*            segment_ids )
+{
+    const size_t  number_segments = segments.Size();
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d one  = _mm256_set1_pd( 1.0 );
+
+    size_t i = 0;
+    for( ; i + 4 <= number_points; i += 4 )
+    {
+        const __m256d px = _mm256_loadu_pd( xs + i );
+        const __m256d py = _mm256_loadu_pd( ys + i );
+        __m256d best     = _mm256_set1_pd( std::numeric_limits<double>::infinity() );
+        __m256d best_seg = zero;
+
+        for( size_t s=0; s<number_segments; s++ )
+        {
+            const __m256d dir_x = _mm256_set1_pd( segments.direction_x[s] );
+            const __m256d dir_y = _mm256_set1_pd( segments.direction_y[s] );
+            const __m256d inv   = _mm256_set1_pd( segments.inv_length2[s] );
+
+            const __m256d dx = _mm256_sub_pd( px, _mm256_set1_pd( segments.origin_x[s] ) );
+            const __m256d dy = _mm256_sub_pd( py, _mm256_set1_pd( segments.origin_y[s] ) );
+            const __m256d t  = _mm256_mul_pd( _mm256_add_pd( _mm256_mul_pd( dx, dir_x ), _mm256_mul_pd( dy, dir_y ) ), inv );
+
+            const __m256d ex = _mm256_sub_pd( px, _mm256_set1_pd( segments.terminus_x[s] ) );
+            const __m256d ey = _mm256_sub_pd( py, _mm256_set1_pd( segments.terminus_y[s] ) );
+
+            const __m256d d_start = _mm256_add_pd( _mm256_mul_pd( dx, dx ), _mm256_mul_pd( dy, dy ) );
+            const __m256d d_end   = _mm256_add_pd( _mm256_mul_pd( ex, ex ), _mm256_mul_pd( ey, ey ) );
+            const __m256d cross   = _mm256_sub_pd( _mm256_mul_pd( dir_x, dy ), _mm256_mul_pd( dx, dir_y ) );
+            const __m256d d_perp  = _mm256_mul_pd( _mm256_mul_pd( cross, cross ), inv );
+
+            const __m256d use_start = _mm256_or_pd( _mm256_cmp_pd( t, zero, _CMP_LE_OQ ),
+                                                    _mm256_cmp_pd( inv, zero, _CMP_LE_OQ ) );
+            const __m256d use_end   = _mm256_cmp_pd( t, one, _CMP_GE_OQ );
+
+            __m256d dist = _mm256_blendv_pd( d_perp, d_end, use_end );
+            dist = _mm256_blendv_pd( dist, d_start, use_start );
+
+            const __m256d closer = _mm256_cmp_pd( dist, best, _CMP_LT_OQ );
+            best     = _mm256_blendv_pd( best, dist, closer );
+            best_seg = _mm256_blendv_pd( best_seg, _mm256_set1_pd( (double)s ), closer );
+        }
+
+        _mm256_storeu_pd( distances2 + i, best );
+        double seg_ids[4];
+        _mm256_storeu_pd( seg_ids, best_seg );
+        for( size_t j=0; j<4; j++ )
+        {
+            segment_ids[i+j] = (uint32_t)seg_ids[j];
+        }
+    }
+
+    // Remainder (Only call out when there is one, leaving the vector code is not free)
+    if( i < number_points )
+    {
+        Nearest_Segment_Scalar( xs, ys, i, number_points, segments, distances2, segment_ids );
+    }
+}
+
+/************************************************/
+/*          AVX-512 Kernel (8 Points/Pass)      */
+/************************************************/
+__attribute__((target("avx512f")))
+static void Nearest_Segment_AVX512( const double*        xs,
+                                    const double*        ys,
+                                    size_t               number_points,
+                                    const Segment_Table& segments,
+                                    double*              distances2,
+                                    uint32_t*            segment_ids )
+{
+    const size_t  number_segments = segments.Size();
+    const __m512d zero = _mm512_setzero_pd();
+    const __m512d one  = _mm512_set1_pd( 1.0 );
+
+    size_t i = 0;
+    for( ; i + 8 <= number_points; i += 8 )
+    {
+        const __m512d px = _mm512_loadu_pd( xs + i );
+        const __m512d py = _mm512_loadu_pd( ys + i );
+        __m512d best     = _mm512_set1_pd( std::numeric_limits<double>::infinity() );
+        __m512d best_seg = zero;
+
+        for( size_t s=0; s<number_segments; s++ )
+        {
+            const __m512d dir_x = _mm512_set1_pd( segments.direction_x[s] );
+            const __m512d dir_y = _mm512_set1_pd( segments.direction_y[s] );
+            const __m512d inv   = _mm512_set1_pd( segments.inv_length2[s] );
+
+            const __m512d dx = _mm512_sub_pd( px, _mm512_set1_pd( segments.origin_x[s] ) );
+            const __m512d dy = _mm512_sub_pd( py, _mm512_set1_pd( segments.origin_y[s] ) );
+            const __m512d t  = _mm512_mul_pd( _mm512_add_pd( _mm512_mul_pd( dx, dir_x ), _mm512_mul_pd( dy, dir_y ) ), inv );
+
+            const __m512d ex = _mm512_sub_pd( px, _mm512_set1_pd( segments.terminus_x[s] ) );
+            const __m512d ey = _mm512_sub_pd( py, _mm512_set1_pd( segments.terminus_y[s] ) );
+
+            const __m512d d_start = _mm512_add_pd( _mm512_mul_pd( dx, dx ), _mm512_mul_pd( dy, dy ) );
+            const __m512d d_end   = _mm512_add_pd( _mm512_mul_pd( ex, ex ), _mm512_mul_pd( ey, ey ) );
+            const __m512d cross   = _mm512_sub_pd( _mm512_mul_pd( dir_x, dy ), _mm512_mul_pd( dx, dir_y ) );
+            const __m512d d_perp  = _mm512_mul_pd( _mm512_mul_pd( cross, cross ), inv );
+
+            const __mmask8 use_start = _mm512_cmp_pd_mask( t, zero, _CMP_LE_OQ ) |
+                                       _mm512_cmp_pd_mask( inv, zero, _CMP_LE_OQ );
+            const __mmask8 use_end   = _mm512_cmp_pd_mask( t, one, _CMP_GE_OQ );
+
+            __m512d dist = _mm512_mask_blend_pd( use_end, d_perp, d_end );
+            dist = _mm512_mask_blend_pd( use_start, dist, d_start );
+
+            const __mmask8 closer = _mm512_cmp_pd_mask( dist, best, _CMP_LT_OQ );
+            best     = _mm512_mask_blend_pd( closer, best, dist );
+            best_seg = _mm512_mask_blend_pd( closer, best_seg, _mm512_set1_pd( (double)s ) );
+        }
+
+        _mm512_storeu_pd( distances2 + i, best );
+        double seg_ids[8];
+        _mm512_storeu_pd( seg_ids, best_seg );
+        for( size_t j=0; j<8; j++ )
+        {
+            segment_ids[i+j] = (uint32_t)seg_ids[j];
+        }
+    }
+
+    // Remainder (Only call out when there is one, leaving the vector code is not free)
+    if( i < number_points )
+    {
+        Nearest_Segment_Scalar( xs, ys, i, number_points, segments, distances2, segment_ids );
+    }
+}
+
+#endif // ROUTE_FINDER_X86_KERNELS
+
+/****************************************************/
+/*          Check Instruction Set Support           */
+/****************************************************/
+bool Is_Supported( Instruction_Set isa )
+{
+    switch( isa )
+    {
+        case Instruction_Set::SCALAR:
+            return true;
+#ifdef ROUTE_FINDER_X86_KERNELS
+        case Instruction_Set::SSE2:
+            return __builtin_cpu_supports( "sse2" );
+        case Instruction_Set::AVX2:
+            return __builtin_cpu_supports( "avx2" );
+        case Instruction_Set::AVX512:
+            return __builtin_cpu_supports( "avx512f" );
+#endif
+        default:
+            return false;
+    }
+}
+
+/************************************************************/
+/*          Select the Best Supported Instruction Set       */
+/************************************************************/
+Instruction_Set Get_Active_Instruction_Set()
+{
+    static const Instruction_Set active_isa = []()
+    {
+        for( auto isa : { Instruction_Set::AVX512,
+                          Instruction_Set::AVX2,
+                          Instruction_Set::SSE2 } )
+        {
+            if( Is_Supported( isa ) )
+            {
+                return isa;
+            }
+        }
+        return Instruction_Set::SCALAR;
+    }();
+    return active_isa;
+}
+
+/****************************************************/
+/*          Nearest Segment (Forced ISA)            */
+/****************************************************/
+void Nearest_Segment( Instruction_Set      isa,
+                      const double*        xs,
+                      const double*        ys,
+                      size_t               number_points,
+                      const Segment_Table& segments,
+                      double*              distances2,
+                      uint32_t*            segment_ids )
+{
+    switch( isa )
+    {
+#ifdef ROUTE_FINDER_X86_KERNELS
+        case Instruction_Set::AVX512:
+            Nearest_Segment_AVX512( xs, ys, number_points, segments, distances2, segment_ids );
+            return;
+        case Instruction_Set::AVX2:
+            Nearest_Segment_AVX2( xs, ys, number_points, segments, distances2, segment_ids );
+            return;
+        case Instruction_Set::SSE2:
+            Nearest_Segment_SSE2( xs, ys, number_points, segments, distances2, segment_ids );
+            return;
+#endif
+        case Instruction_Set::SCALAR:
+            Nearest_Segment_Scalar( xs, ys, 0, number_points, segments, distances2, segment_ids );
+            return;
+        default:
+            throw std::invalid_argument( "Unsupported instruction set: " + To_String( isa ) );
+    }
+}
+
+/****************************************************/
+/*          Nearest Segment (Active ISA)            */
+/****************************************************/
+void Nearest_Segment( const double*        xs,
+                      const double*        ys,
+                      size_t               number_points,
+                      const Segment_Table& segments,
+                      double*              distances2,
+                      uint32_t*            segment_ids )
+{
+    Nearest_Segment( Get_Active_Instruction_Set(),
+                     xs, ys, number_points,
+                     segments,
+                     distances2,
+                     segment_ids );
+}
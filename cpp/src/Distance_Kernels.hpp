@@ -0,0 +1,120 @@
+/**
+ * @file    Distance_Kernels.hpp
+ * @author  Marvin Smith
+ * @date    1/10/2021
+ */
+#pragma once
+
+// C++ Libraries
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Instruction Sets the distance kernels are built for
+ */
+enum class Instruction_Set
+{
+    SCALAR  = 0,
+    SSE2    = 1,
+    AVX2    = 2,
+    AVX512  = 3,
+}; // End of Instruction_Set Enum
+
+/**
+ * @brief Convert the instruction set to a log-friendly string
+ */
+std::string To_String( Instruction_Set isa );
+
+/**
+ * @class Segment_Table
+ * @brief Structure-of-arrays layout of the route segments fed to the kernels.
+ */
+struct Segment_Table
+{
+    /**
+     * @brief Resize all of the columns
+     */
+    void Resize( size_t number_segments );
+
+    /**
+     * @brief Get the number of segments
+     */
+    size_t Size() const
+    {
+        return origin_x.size();
+    }
+
+    // Segment Start
+    std::vector<double> origin_x;
+    std::vector<double> origin_y;
+
+    // Segment End
+    std::vector<double> terminus_x;
+    std::vector<double> terminus_y;
+
+    // End minus Start
+    std::vector<double> direction_x;
+    std::vector<double> direction_y;
+
+    // Inverse squared length (0 if degenerate)
+    std::vector<double> inv_length2;
+
+}; // End of Segment_Table Struct
+
+/**
+ * @brief Squared distance from a point to one segment of the table.
+ *
+ * This is the reference formula.  The vector kernels evaluate exactly the
+ * same operations in the same order so that every instruction set returns
+ * identical results.
+ *
+ * @note Defined out of line, so callers get the -ffp-contract=off build of it
+ *       and agree with the kernels to the last bit.
+ */
+double Segment_Distance2( const Segment_Table& segments,
+                          size_t               seg_idx,
+                          double               px,
+                          double               py );
+
+/**
+ * @brief For each point, find the nearest segment and the squared distance to it.
+ *
+ * Ties go to the earliest segment.  Dispatches to the best instruction set
+ * detected on this CPU.
+ *
+ * @param xs X coordinates of the reference points
+ * @param ys Y coordinates of the reference points
+ * @param number_points Number of reference points
+ * @param segments Route segments (must not be empty)
+ * @param distances2 Output squared distance per point
+ * @param segment_ids Output nearest segment index per point
+ */
+void Nearest_Segment( const double*        xs,
+                      const double*        ys,
+                      size_t               number_points,
+                      const Segment_Table& segments,
+                      double*              distances2,
+                      uint32_t*            segment_ids );
+
+/**
+ * @brief Same as Nearest_Segment, but forcing a specific instruction set.
+ * @note The instruction set must be supported (see Is_Supported).
+ */
+void Nearest_Segment( Instruction_Set      isa,
+                      const double*        xs,
+                      const double*        ys,
+                      size_t               number_points,
+                      const Segment_Table& segments,
+                      double*              distances2,
+                      uint32_t*            segment_ids );
+
+/**
+ * @brief Check if the CPU supports the instruction set
+ */
+bool Is_Supported( Instruction_Set isa );
+
+/**
+ * @brief Get the instruction set selected at startup
+ */
+Instruction_Set Get_Active_Instruction_Set();
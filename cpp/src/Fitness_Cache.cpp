@@ -0,0 +1,139 @@
+/**
+ * @file    Fitness_Cache.cpp
+ * @author  Marvin Smith
+ * @date    1/14/2021
+ */
+#include "Fitness_Cache.hpp"
+
+/****************************************************/
+/*          Bloom Filter Bit Positions              */
+/****************************************************/
+static size_t Bloom_Index_1( uint64_t key, size_t shift )
+{
+    return key >> shift;
+}
+
+static size_t Bloom_Index_2( uint64_t key, size_t shift )
+{
+    return ( key * 0x9E3779B97F4A7C15ULL ) >> shift;
+}
+
+/********************************/
+/*          Constructor         */
+/********************************/
+Fitness_Cache::Fitness_Cache( size_t capacity )
+{
+    if( capacity == 0 )
+    {
+        return;
+    }
+
+    // Spread a power-of-two capacity over the shards
+    m_shard_size = 1;
+    while( NUMBER_SHARDS * m_shard_size < capacity )
+    {
+        m_shard_size *= 2;
+    }
+    for( auto& shard : m_shards )
+    {
+        shard.entries.resize( m_shard_size );
+    }
+
+    // Bloom filter bits are a power of two as well, so an index is just the top bits of a hash
+    size_t bloom_bits = 64;
+    m_bloom_bit_shift = 58;
+    while( bloom_bits < BLOOM_BITS_PER_ENTRY * Get_Capacity() )
+    {
+        bloom_bits *= 2;
+        m_bloom_bit_shift--;
+    }
+    m_bloom_words = std::vector<std::atomic_uint64_t>( bloom_bits / 64 );
+}
+
+/************************************/
+/*          Look up a Score         */
+/************************************/
+bool Fitness_Cache::Find( uint64_t key,
+                          double&  fitness )
+{
+    if( m_shard_size == 0 )
+    {
+        return false;
+    }
+
+    // Most new genomes stop here without touching a lock
+    if( !Bloom_Check( key ) )
+    {
+        m_filtered++;
+        m_misses++;
+        return false;
+    }
+
+    auto& shard = m_shards[key >> ( 64 - SHARD_BITS )];
+    {
+        std::lock_guard<std::mutex> lck( shard.mtx );
+        const auto& entry = shard.entries[key & ( m_shard_size - 1 )];
+        if( entry.fitness >= 0 && entry.key == key )
+        {
+            fitness = entry.fitness;
+            m_hits++;
+            return true;
+        }
+    }
+    m_misses++;
+    return false;
+}
+
+/************************************/
+/*          Store a Score           */
+/************************************/
+void Fitness_Cache::Insert( uint64_t key,
+                            double   fitness )
+{
+    if( m_shard_size == 0 || fitness < 0 )
+    {
+        return;
+    }
+
+    auto& shard = m_shards[key >> ( 64 - SHARD_BITS )];
+    {
+        std::lock_guard<std::mutex> lck( shard.mtx );
+        auto& entry = shard.entries[key & ( m_shard_size - 1 )];
+        entry.key     = key;
+        entry.fitness = fitness;
+    }
+    Bloom_Insert( key );
+}
+
+/****************************************************/
+/*          Check the Bloom Filter                  */
+/****************************************************/
+bool Fitness_Cache::Bloom_Check( uint64_t key ) const
+{
+    size_t idx1 = Bloom_Index_1( key, m_bloom_bit_shift );
+    size_t idx2 = Bloom_Index_2( key, m_bloom_bit_shift );
+    return ( m_bloom_words[idx1 / 64].load( std::memory_order_relaxed ) & ( uint64_t(1) << ( idx1 % 64 ) ) ) &&
+           ( m_bloom_words[idx2 / 64].load( std::memory_order_relaxed ) & ( uint64_t(1) << ( idx2 % 64 ) ) );
+}
+
+/****************************************************/
+/*          Add to the Bloom Filter                 */
+/****************************************************/
+void Fitness_Cache::Bloom_Insert( uint64_t key )
+{
+    // Past one insert per 8 bits, the false positive rate climbs quickly.  Start over; lost bits only cost misses.
+    const size_t max_inserts = m_bloom_words.size() * 8;
+    if( ++m_bloom_inserts > max_inserts )
+    {
+        m_bloom_inserts = 0;
+        for( auto& word : m_bloom_words )
+        {
+            word.store( 0, std::memory_order_relaxed );
+        }
+    }
+
+    size_t idx1 = Bloom_Index_1( key, m_bloom_bit_shift );
+    size_t idx2 = Bloom_Index_2( key, m_bloom_bit_shift );
+    m_bloom_words[idx1 / 64].fetch_or( uint64_t(1) << ( idx1 % 64 ), std::memory_order_relaxed );
+    m_bloom_words[idx2 / 64].fetch_or( uint64_t(1) << ( idx2 % 64 ), std::memory_order_relaxed );
+}
@@ -0,0 +1,128 @@
+/**
+ * @file    Fitness_Cache.hpp
+ * @author  Marvin Smith
+ * @date    1/14/2021
+ */
+#pragma once
+
+// C++ Libraries
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/**
+ * @class Fitness_Cache
+ * @brief Bounded, thread-safe map from genome hash to fitness score.
+ *
+ * Entries live in a direct-mapped table split into independently locked shards,
+ * so a new score simply replaces whatever shared its slot.  A Bloom filter in
+ * front answers "never seen" without taking a lock.  The filter is cleared once
+ * it fills up; that only costs a few extra misses, never a wrong score.
+ *
+ * Only valid for a single fitness function and context (e.g. one GA run).
+ */
+class Fitness_Cache
+{
+    public:
+
+        /**
+         * @brief Constructor
+         * @param capacity Max number of entries (Rounded up to a power of two, 0 disables the cache)
+         */
+        explicit Fitness_Cache( size_t capacity );
+
+        /**
+         * @brief Look up the fitness for a genome hash
+         * @return True on a hit, with the score written to fitness
+         */
+        bool Find( uint64_t key,
+                   double&  fitness );
+
+        /**
+         * @brief Store the fitness for a genome hash
+         */
+        void Insert( uint64_t key,
+                     double   fitness );
+
+        /**
+         * @brief Get the number of entries the cache can hold
+         */
+        size_t Get_Capacity() const
+        {
+            return NUMBER_SHARDS * m_shard_size;
+        }
+
+        /**
+         * @brief Get the number of successful lookups
+         */
+        size_t Get_Hits() const
+        {
+            return m_hits;
+        }
+
+        /**
+         * @brief Get the number of failed lookups
+         */
+        size_t Get_Misses() const
+        {
+            return m_misses;
+        }
+
+        /**
+         * @brief Get the number of misses answered by the Bloom filter alone
+         */
+        size_t Get_Filtered() const
+        {
+            return m_filtered;
+        }
+
+    private:
+
+        /**
+         * @brief Check the Bloom filter bits for the key
+         * @return False if the key was definitely never inserted
+         */
+        bool Bloom_Check( uint64_t key ) const;
+
+        /**
+         * @brief Set the Bloom filter bits for the key (Clears the filter first if it is full)
+         */
+        void Bloom_Insert( uint64_t key );
+
+        /// Number of independently locked shards (Selected by the top bits of the key)
+        static constexpr size_t SHARD_BITS    = 6;
+        static constexpr size_t NUMBER_SHARDS = size_t(1) << SHARD_BITS;
+
+        /// Bloom filter bits per cache entry
+        static constexpr size_t BLOOM_BITS_PER_ENTRY = 16;
+
+        /// Table Entry (Negative fitness marks an empty slot)
+        struct Entry
+        {
+            uint64_t key { 0 };
+            double   fitness { -1 };
+        };
+
+        /// One locked slice of the table
+        struct Shard
+        {
+            std::mutex         mtx;
+            std::vector<Entry> entries;
+        };
+
+        std::array<Shard,NUMBER_SHARDS> m_shards;
+        size_t m_shard_size { 0 };
+
+        /// Bloom Filter
+        std::vector<std::atomic_uint64_t> m_bloom_words;
+        size_t m_bloom_bit_shift { 64 };
+        std::atomic_size_t m_bloom_inserts { 0 };
+
+        /// Counters
+        std::atomic_size_t m_hits { 0 };
+        std::atomic_size_t m_misses { 0 };
+        std::atomic_size_t m_filtered { 0 };
+
+}; // End of Fitness_Cache Class
@@ -0,0 +1,459 @@
+/**
+ * @file    Fitness_Engine.cpp
+ * @author  Marvin Smith
+ * @date    1/9/2021
+ */
+#include "Fitness_Engine.hpp"
+
+// C++ Libraries
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+/************************************************/
+/*          Get the Thread-Local Engine         */
+/************************************************/
+Fitness_Engine& Fitness_Engine::Thread_Instance()
+{
+    thread_local Fitness_Engine engine;
+    return engine;
+}
+
+/************************************************/
+/*          Compute Segment Invariants          */
+/************************************************/
+void Fitness_Engine::Set_Vertices( Span<const Point> vertices )
+{
+    const size_t number_segments = vertices.size() > 1 ? vertices.size() - 1 : 0;
+    m_segments.Resize( number_segments );
+    m_segment_lengths.resize( number_segments );
+    m_distance_sums.assign( number_segments, 0 );
+    m_point_counts.assign( number_segments, 0 );
+    m_number_points = 0;
+
+    for( size_t seg_idx=0; seg_idx<number_segments; seg_idx++ )
+    {
+        const auto direction = vertices[seg_idx+1] - vertices[seg_idx];
+        m_segments.origin_x[seg_idx]    = vertices[seg_idx].x();
+        m_segments.origin_y[seg_idx]    = vertices[seg_idx].y();
+        m_segments.terminus_x[seg_idx]  = vertices[seg_idx+1].x();
+        m_segments.terminus_y[seg_idx]  = vertices[seg_idx+1].y();
+        m_segments.direction_x[seg_idx] = direction.x();
+        m_segments.direction_y[seg_idx] = direction.y();
+        m_segment_lengths[seg_idx]      = direction.Mag();
+
+        // If the 2 line segment points are the same, treat as a single point
+        m_segments.inv_length2[seg_idx] = ( m_segment_lengths[seg_idx] < 0.01 ) ? 0 : 1.0 / direction.Mag2();
+    }
+}
+
+/****************************************************/
+/*          Assign Points to Nearest Segment        */
+/****************************************************/
+void Fitness_Engine::Assign( Span<const double> xs,
+                             Span<const double> ys,
+                             Span<const Point>  vertices )
+{
+    assert( xs.size() == ys.size() );
+    Set_Vertices( vertices );
+    m_number_points = xs.size();
+
+    if( m_segments.Size() == 0 )
+    {
+        return;
+    }
+
+    // Find the nearest segment for every point
+    m_point_distances2.resize( m_number_points );
+    m_point_segments.resize( m_number_points );
+    if( Uses_Culling( m_segments.Size() ) )
+    {
+        Assign_Culled( xs, ys );
+    }
+    else
+    {
+        Nearest_Segment( xs.data(),
+                         ys.data(),
+                         m_number_points,
+                         m_segments,
+                         m_point_distances2.data(),
+                         m_point_segments.data() );
+    }
+
+    // Accumulate per segment
+    for( size_t point_id=0; point_id<m_number_points; point_id++ )
+    {
+        m_distance_sums[m_point_segments[point_id]] += std::sqrt( m_point_distances2[point_id] );
+        m_point_counts[m_point_segments[point_id]]++;
+    }
+}
+
+/****************************************************/
+/*          Assign Points to Nearest Segment        */
+/****************************************************/
+void Fitness_Engine::Assign( Span<const Point> point_list,
+                             Span<const Point> vertices )
+{
+    m_scratch_x.resize( point_list.size() );
+    m_scratch_y.resize( point_list.size() );
+    for( size_t point_id=0; point_id<point_list.size(); point_id++ )
+    {
+        m_scratch_x[point_id] = point_list[point_id].x();
+        m_scratch_y[point_id] = point_list[point_id].y();
+    }
+    Assign( m_scratch_x, m_scratch_y, vertices );
+}
+
+/************************************************/
+/*          Update a Previous Assignment        */
+/************************************************/
+void Fitness_Engine::Reassign( Span<const double> xs,
+                               Span<const double> ys,
+                               Span<const Point>  vertices,
+                               Span<uint8_t>      point_segments,
+                               uint64_t           moved_segments )
+{
+    assert( xs.size() == ys.size() );
+    assert( xs.size() == point_segments.size() );
+    Set_Vertices( vertices );
+    m_number_points = xs.size();
+
+    const size_t number_segments = m_segments.Size();
+    if( number_segments == 0 )
+    {
+        return;
+    }
+    if( number_segments < 64 )
+    {
+        moved_segments &= ( uint64_t(1) << number_segments ) - 1;
+    }
+
+    // Points on unmoved segments keep their distance, so it is recomputed from the segment alone.
+    // Points on moved segments could now be closest to anything, so queue them for a full rescan.
+    m_point_distances2.resize( m_number_points );
+    m_point_segments.resize( m_number_points );
+    m_rescan_ids.clear();
+    m_scratch_x.clear();
+    m_scratch_y.clear();
+    for( size_t point_id=0; point_id<m_number_points; point_id++ )
+    {
+        const size_t current_seg = point_segments[point_id];
+        m_point_segments[point_id] = current_seg;
+        if( (moved_segments >> current_seg) & 1 )
+        {
+            m_point_distances2[point_id] = 0;
+            m_rescan_ids.push_back( point_id );
+            m_scratch_x.push_back( xs[point_id] );
+            m_scratch_y.push_back( ys[point_id] );
+            continue;
+        }
+        m_point_distances2[point_id] = Segment_Distance2( m_segments, current_seg, xs[point_id], ys[point_id] );
+    }
+
+    // Distance from every block center to every moved segment
+    m_moved_ids.clear();
+    for( uint64_t mask = moved_segments; mask != 0; mask &= (mask - 1) )
+    {
+        m_moved_ids.push_back( __builtin_ctzll( mask ) );
+    }
+    const size_t number_blocks = Compute_Blocks( xs, ys );
+    m_center_distances2.resize( m_moved_ids.size() * number_blocks );
+    m_center_ids.resize( number_blocks );
+    Select_Segments( m_segments, m_moved_ids, m_moved_segments );
+    for( size_t moved_idx=0; moved_idx<m_moved_ids.size(); moved_idx++ )
+    {
+        m_block_ids.assign( 1, m_moved_ids[moved_idx] );
+        Select_Segments( m_segments, m_block_ids, m_block_segments );
+        Nearest_Segment( m_center_x.data(),
+                         m_center_y.data(),
+                         number_blocks,
+                         m_block_segments,
+                         m_center_distances2.data() + moved_idx * number_blocks,
+                         m_center_ids.data() );
+    }
+
+    // Only the moved segments that could beat the farthest point of a block are checked against it
+    m_block_distances2.resize( CULL_BLOCK_SIZE );
+    m_block_point_segments.resize( CULL_BLOCK_SIZE );
+    for( size_t block_idx=0; block_idx<number_blocks; block_idx++ )
+    {
+        const size_t block_start = block_idx * CULL_BLOCK_SIZE;
+        const size_t block_size  = std::min( CULL_BLOCK_SIZE, m_number_points - block_start );
+        double farthest2 = 0;
+        for( size_t point_id=block_start; point_id<block_start+block_size; point_id++ )
+        {
+            farthest2 = std::max( farthest2, m_point_distances2[point_id] );
+        }
+
+        // Every point is within half the diagonal of the center.  The slack covers rounding.
+        const double cull = std::sqrt( farthest2 ) + 0.5 * m_block_diagonals[block_idx];
+        const double cull2 = cull * cull * ( 1 + 1e-9 ) + 1e-9;
+        m_block_ids.clear();
+        for( size_t moved_idx=0; moved_idx<m_moved_ids.size(); moved_idx++ )
+        {
+            if( m_center_distances2[moved_idx * number_blocks + block_idx] <= cull2 )
+            {
+                m_block_ids.push_back( m_moved_ids[moved_idx] );
+            }
+        }
+        if( m_block_ids.empty() )
+        {
+            continue;
+        }
+        const bool all_moved = ( m_block_ids.size() == m_moved_ids.size() );
+        if( !all_moved )
+        {
+            Select_Segments( m_segments, m_block_ids, m_block_segments );
+        }
+        Nearest_Segment( xs.data() + block_start,
+                         ys.data() + block_start,
+                         block_size,
+                         all_moved ? m_moved_segments : m_block_segments,
+                         m_block_distances2.data(),
+                         m_block_point_segments.data() );
+
+        // Ties go to the earliest segment, same as the full assignment
+        for( size_t i=0; i<block_size; i++ )
+        {
+            const size_t point_id    = block_start + i;
+            const size_t current_seg = m_point_segments[point_id];
+            if( (moved_segments >> current_seg) & 1 )
+            {
+                continue;
+            }
+            const size_t moved_seg  = m_block_ids[m_block_point_segments[i]];
+            const double moved_dist = m_block_distances2[i];
+            if( moved_dist < m_point_distances2[point_id] ||
+                ( moved_dist == m_point_distances2[point_id] && moved_seg < current_seg ) )
+            {
+                m_point_distances2[point_id] = moved_dist;
+                m_point_segments[point_id]   = moved_seg;
+            }
+        }
+    }
+
+    // Full rescan of the displaced points
+    if( !m_rescan_ids.empty() )
+    {
+        m_block_distances2.resize( m_rescan_ids.size() );
+        m_block_point_segments.resize( m_rescan_ids.size() );
+        Nearest_Segment( m_scratch_x.data(),
+                         m_scratch_y.data(),
+                         m_rescan_ids.size(),
+                         m_segments,
+                         m_block_distances2.data(),
+                         m_block_point_segments.data() );
+        for( size_t i=0; i<m_rescan_ids.size(); i++ )
+        {
+            m_point_distances2[m_rescan_ids[i]] = m_block_distances2[i];
+            m_point_segments[m_rescan_ids[i]]   = m_block_point_segments[i];
+        }
+    }
+
+    // Accumulate per segment, in point order so the sums match a full assignment
+    for( size_t point_id=0; point_id<m_number_points; point_id++ )
+    {
+        m_distance_sums[m_point_segments[point_id]] += std::sqrt( m_point_distances2[point_id] );
+        m_point_counts[m_point_segments[point_id]]++;
+        point_segments[point_id] = m_point_segments[point_id];
+    }
+}
+
+/****************************************************/
+/*          Pick Between Reassign and Assign        */
+/****************************************************/
+bool Fitness_Engine::Prefers_Reassign( size_t number_segments,
+                                       size_t number_moved )
+{
+    return Uses_Culling( number_segments ) &&
+           REASSIGN_SEGMENT_RATIO * number_moved <= number_segments;
+}
+
+/****************************************************/
+/*          Compute the Culling Block Bounds        */
+/****************************************************/
+size_t Fitness_Engine::Compute_Blocks( Span<const double> xs,
+                                       Span<const double> ys )
+{
+    const size_t number_blocks = ( m_number_points + CULL_BLOCK_SIZE - 1 ) / CULL_BLOCK_SIZE;
+    m_center_x.resize( number_blocks );
+    m_center_y.resize( number_blocks );
+    m_block_diagonals.resize( number_blocks );
+    for( size_t block_idx=0; block_idx<number_blocks; block_idx++ )
+    {
+        const size_t block_start = block_idx * CULL_BLOCK_SIZE;
+        const size_t block_stop  = std::min( block_start + CULL_BLOCK_SIZE, m_number_points );
+        double min_x = xs[block_start], max_x = xs[block_start];
+        double min_y = ys[block_start], max_y = ys[block_start];
+        for( size_t point_id=block_start+1; point_id<block_stop; point_id++ )
+        {
+            min_x = std::min( min_x, xs[point_id] );
+            max_x = std::max( max_x, xs[point_id] );
+            min_y = std::min( min_y, ys[point_id] );
+            max_y = std::max( max_y, ys[point_id] );
+        }
+        m_center_x[block_idx] = 0.5 * ( min_x + max_x );
+        m_center_y[block_idx] = 0.5 * ( min_y + max_y );
+        m_block_diagonals[block_idx] = std::sqrt( ( max_x - min_x ) * ( max_x - min_x ) + ( max_y - min_y ) * ( max_y - min_y ) );
+    }
+    return number_blocks;
+}
+
+/********************************************************/
+/*          Assign Points, Culling Segments per Block   */
+/********************************************************/
+void Fitness_Engine::Assign_Culled( Span<const double> xs,
+                                    Span<const double> ys )
+{
+    const size_t number_segments = m_segments.Size();
+    const size_t number_blocks   = Compute_Blocks( xs, ys );
+
+    // Distance from every center to every segment, one segment at a time so the kernels vectorize over the centers
+    m_center_distances2.resize( number_segments * number_blocks );
+    m_center_ids.resize( number_blocks );
+    m_block_ids.resize( 1 );
+    for( size_t seg_idx=0; seg_idx<number_segments; seg_idx++ )
+    {
+        m_block_ids[0] = seg_idx;
+        Select_Segments( m_segments, m_block_ids, m_block_segments );
+        Nearest_Segment( m_center_x.data(),
+                         m_center_y.data(),
+                         number_blocks,
+                         m_block_segments,
+                         m_center_distances2.data() + seg_idx * number_blocks,
+                         m_center_ids.data() );
+    }
+
+    for( size_t block_idx=0; block_idx<number_blocks; block_idx++ )
+    {
+        const size_t block_start = block_idx * CULL_BLOCK_SIZE;
+        const size_t block_size  = std::min( CULL_BLOCK_SIZE, m_number_points - block_start );
+
+        // Distance from any point of the block to a segment is within half the block
+        // diagonal of the center's distance, so a segment can only be nearest to some
+        // point if the center is no more than a full diagonal farther from it than from
+        // the closest segment.
+        double nearest2 = std::numeric_limits<double>::max();
+        for( size_t seg_idx=0; seg_idx<number_segments; seg_idx++ )
+        {
+            nearest2 = std::min( nearest2, m_center_distances2[seg_idx * number_blocks + block_idx] );
+        }
+
+        // The slack covers rounding, so the answer matches a full scan exactly
+        const double cull = std::sqrt( nearest2 ) + m_block_diagonals[block_idx];
+        const double cull2 = cull * cull * ( 1 + 1e-9 ) + 1e-9;
+        m_block_ids.clear();
+        for( size_t seg_idx=0; seg_idx<number_segments; seg_idx++ )
+        {
+            if( m_center_distances2[seg_idx * number_blocks + block_idx] <= cull2 )
+            {
+                m_block_ids.push_back( seg_idx );
+            }
+        }
+
+        // Surviving segments keep their order, so ties still go to the earliest one
+        if( m_block_ids.size() == number_segments )
+        {
+            Nearest_Segment( xs.data() + block_start,
+                             ys.data() + block_start,
+                             block_size,
+                             m_segments,
+                             m_point_distances2.data() + block_start,
+                             m_point_segments.data() + block_start );
+            continue;
+        }
+        Select_Segments( m_segments, m_block_ids, m_block_segments );
+        Nearest_Segment( xs.data() + block_start,
+                         ys.data() + block_start,
+                         block_size,
+                         m_block_segments,
+                         m_point_distances2.data() + block_start,
+                         m_point_segments.data() + block_start );
+        for( size_t point_id=block_start; point_id<block_start+block_size; point_id++ )
+        {
+            m_point_segments[point_id] = m_block_ids[m_point_segments[point_id]];
+        }
+    }
+}
+
+/****************************************************/
+/*          Copy Rows of a Segment Table            */
+/****************************************************/
+void Fitness_Engine::Select_Segments( const Segment_Table&         segments,
+                                      const std::vector<uint32_t>& segment_ids,
+                                      Segment_Table&               output )
+{
+    output.Resize( segment_ids.size() );
+    for( size_t i=0; i<segment_ids.size(); i++ )
+    {
+        const auto seg_idx = segment_ids[i];
+        output.origin_x[i]    = segments.origin_x[seg_idx];
+        output.origin_y[i]    = segments.origin_y[seg_idx];
+        output.terminus_x[i]  = segments.terminus_x[seg_idx];
+        output.terminus_y[i]  = segments.terminus_y[seg_idx];
+        output.direction_x[i] = segments.direction_x[seg_idx];
+        output.direction_y[i] = segments.direction_y[seg_idx];
+        output.inv_length2[i] = segments.inv_length2[seg_idx];
+    }
+}
+
+/****************************************/
+/*          Compute the Score           */
+/****************************************/
+double Fitness_Engine::Score( Fitness_Method method ) const
+{
+    switch( method )
+    {
+        case Fitness_Method::SCORE_01:
+            return Score_01();
+        case Fitness_Method::SCORE_02:
+            return Score_02();
+        case Fitness_Method::SCORE_03:
+        default:
+            return Score_03();
+    }
+}
+
+/********************************************/
+/*          Segment Density Score           */
+/********************************************/
+double Fitness_Engine::Score_01() const
+{
+    double total_route_len = 0;
+    double total_seg_ratio = 0;
+    for( size_t seg_idx=0; seg_idx<m_segments.Size(); seg_idx++ )
+    {
+        total_route_len += m_segment_lengths[seg_idx];
+        total_seg_ratio += std::pow( m_segment_lengths[seg_idx] / (m_point_counts[seg_idx]+1), 2 );
+    }
+    return (m_number_points / total_route_len) * total_seg_ratio;
+}
+
+/************************************************/
+/*          Mean Segment Distance Score         */
+/************************************************/
+double Fitness_Engine::Score_02() const
+{
+    double score = 0;
+    for( size_t seg_idx=0; seg_idx<m_segments.Size(); seg_idx++ )
+    {
+        score += std::pow( m_distance_sums[seg_idx] / (m_point_counts[seg_idx]+1), 2 );
+    }
+    return score;
+}
+
+/************************************************/
+/*          Route-Length Weighted Score         */
+/************************************************/
+double Fitness_Engine::Score_03() const
+{
+    double score = 0;
+    double total_length = 0;
+    for( size_t seg_idx=0; seg_idx<m_segments.Size(); seg_idx++ )
+    {
+        score        += m_distance_sums[seg_idx];
+        total_length += m_segment_lengths[seg_idx];
+    }
+    return score * total_length;
+}
@@ -0,0 +1,264 @@
+/**
+ * @file    Fitness_Engine.hpp
+ * @author  Marvin Smith
+ * @date    1/9/2021
+ */
+#pragma once
+
+// C++ Libraries
+#include <cstdint>
+#include <vector>
+
+// Project Libraries
+#include "Distance_Kernels.hpp"
+#include "Point.hpp"
+#include "Span.hpp"
+
+/**
+ * @brief Fitness Scoring Methods
+ */
+enum class Fitness_Method
+{
+    SCORE_01 = 1,
+    SCORE_02 = 2,
+    SCORE_03 = 3,
+}; // End of Fitness_Method Enum
+
+/**
+ * @class Fitness_Engine
+ * @brief Assigns each reference point to its nearest route segment in a single pass.
+ *
+ * The per-segment distance sums and point counts are kept in flat arrays that are
+ * reused between calls, so once warmed up a thread never allocates.  Each scoring
+ * method is a cheap reduction over those accumulators.  The nearest-segment search
+ * itself runs in the vectorized kernels from Distance_Kernels.hpp.
+ *
+ * Long routes are culled per block of consecutive points first: a segment only
+ * reaches the kernels for a block if, measured from the block center, it could
+ * beat the best distance another segment guarantees for every point of the block.
+ * Reference points arrive in track order, so blocks are compact and most points
+ * only see a handful of segments.  The result is identical to a full scan.
+ */
+class Fitness_Engine
+{
+    public:
+
+        /**
+         * @brief Get the engine instance owned by the calling thread.
+         */
+        static Fitness_Engine& Thread_Instance();
+
+        /**
+         * @brief Compute the segment invariants and reset the accumulators
+         * @param vertices Route vertices, including start and end points
+         */
+        void Set_Vertices( Span<const Point> vertices );
+
+        /**
+         * @brief Assign every reference point to its nearest segment and accumulate
+         * @param xs Reference point X coordinates
+         * @param ys Reference point Y coordinates
+         * @param vertices Route vertices, including start and end points
+         */
+        void Assign( Span<const double> xs,
+                     Span<const double> ys,
+                     Span<const Point>  vertices );
+
+        /**
+         * @brief Assign every reference point to its nearest segment and accumulate
+         * @param point_list Reference points
+         * @param vertices Route vertices, including start and end points
+         * @note Converts the points to structure-of-arrays form first.
+         */
+        void Assign( Span<const Point> point_list,
+                     Span<const Point> vertices );
+
+        /**
+         * @brief Update a previous assignment after some segments moved
+         *
+         * Only the distances to the moved segments are new.  Each point's old distance
+         * comes from its own segment, and a block of points only meets the moved segments
+         * that could beat its farthest point.  Points whose nearest segment moved are
+         * rescanned against every segment.  Produces exactly the same result as a full
+         * Assign.
+         *
+         * @param xs Reference point X coordinates
+         * @param ys Reference point Y coordinates
+         * @param vertices Route vertices, including start and end points
+         * @param point_segments Nearest segment per point from the previous assignment (Updated)
+         * @param moved_segments Bit mask of the segments whose end points moved
+         */
+        void Reassign( Span<const double> xs,
+                       Span<const double> ys,
+                       Span<const Point>  vertices,
+                       Span<uint8_t>      point_segments,
+                       uint64_t           moved_segments );
+
+        /**
+         * @brief Check if Assign culls segments per block of points for a route this long
+         */
+        static bool Uses_Culling( size_t number_segments )
+        {
+            return number_segments >= CULL_MIN_SEGMENTS;
+        }
+
+        /**
+         * @brief Check if Reassign beats a full Assign
+         *
+         * Short routes are scanned without culling, which no update can beat.  On
+         * culled routes, Reassign pays off while few of the segments moved.
+         */
+        static bool Prefers_Reassign( size_t number_segments,
+                                      size_t number_moved );
+
+        /**
+         * @brief Compute the score for the last assignment
+         */
+        double Score( Fitness_Method method ) const;
+
+        /**
+         * @brief Segment Density Score (Sum of squared segment length per point)
+         */
+        double Score_01() const;
+
+        /**
+         * @brief Sum of squared mean distance per segment
+         */
+        double Score_02() const;
+
+        /**
+         * @brief Total point distance scaled by route length
+         */
+        double Score_03() const;
+
+        /**
+         * @brief Get the number of segments in the last assignment
+         */
+        size_t Get_Number_Segments() const
+        {
+            return m_segments.Size();
+        }
+
+        /**
+         * @brief Get the segment length
+         */
+        double Get_Segment_Length( size_t seg_idx ) const
+        {
+            return m_segment_lengths[seg_idx];
+        }
+
+        /**
+         * @brief Get the sum of point distances assigned to the segment
+         */
+        double Get_Distance_Sum( size_t seg_idx ) const
+        {
+            return m_distance_sums[seg_idx];
+        }
+
+        /**
+         * @brief Get the nearest segment per point from the last assignment
+         */
+        const std::vector<uint32_t>& Get_Point_Segments() const
+        {
+            return m_point_segments;
+        }
+
+        /**
+         * @brief Get the squared distance per point from the last assignment
+         */
+        const std::vector<double>& Get_Point_Distances2() const
+        {
+            return m_point_distances2;
+        }
+
+        /**
+         * @brief Get the number of points assigned to the segment
+         */
+        uint32_t Get_Point_Count( size_t seg_idx ) const
+        {
+            return m_point_counts[seg_idx];
+        }
+
+    private:
+
+        /// Consecutive points per culling block
+        static constexpr size_t CULL_BLOCK_SIZE = 64;
+
+        /// Fewest segments worth culling (The kernels scan short routes faster)
+        static constexpr size_t CULL_MIN_SEGMENTS = 12;
+
+        /// Segments per moved segment for Reassign to pay off (Past that, a full assignment is faster)
+        static constexpr size_t REASSIGN_SEGMENT_RATIO = 5;
+
+        /**
+         * @brief Compute the center and diagonal of every block of points
+         * @return Number of blocks
+         */
+        size_t Compute_Blocks( Span<const double> xs,
+                               Span<const double> ys );
+
+        /**
+         * @brief Assign every point, culling segments per block of points
+         */
+        void Assign_Culled( Span<const double> xs,
+                            Span<const double> ys );
+
+        /**
+         * @brief Copy some rows of a segment table into another
+         */
+        static void Select_Segments( const Segment_Table&         segments,
+                                     const std::vector<uint32_t>& segment_ids,
+                                     Segment_Table&               output );
+
+        /// Segment Invariants (Structure-of-Arrays for the Distance Kernels)
+        Segment_Table m_segments;
+
+        /// Segment Lengths
+        std::vector<double> m_segment_lengths;
+
+        /// Per-Segment Distance Sums
+        std::vector<double> m_distance_sums;
+
+        /// Per-Segment Point Counts
+        std::vector<uint32_t> m_point_counts;
+
+        /// Per-Point Squared Distance to the Nearest Segment
+        std::vector<double> m_point_distances2;
+
+        /// Per-Point Nearest Segment
+        std::vector<uint32_t> m_point_segments;
+
+        /// Scratch Coordinates for Array-of-Structures Input and Rescans
+        std::vector<double> m_scratch_x;
+        std::vector<double> m_scratch_y;
+
+        /// Moved Segments used by Reassign
+        Segment_Table m_moved_segments;
+        std::vector<uint32_t> m_moved_ids;
+
+        /// Points queued for a full rescan by Reassign
+        std::vector<size_t> m_rescan_ids;
+
+        /// Culling block centers and diagonals
+        std::vector<double> m_center_x;
+        std::vector<double> m_center_y;
+        std::vector<double> m_block_diagonals;
+
+        /// Squared distance from each block center to each segment (Segment major)
+        std::vector<double> m_center_distances2;
+
+        /// Segment ids the kernels return for the centers (Always 0, one segment per pass)
+        std::vector<uint32_t> m_center_ids;
+
+        /// Segments that survive culling for one block of points
+        Segment_Table m_block_segments;
+        std::vector<uint32_t> m_block_ids;
+
+        /// Kernel output for one block, or for the points Reassign rescans
+        std::vector<double> m_block_distances2;
+        std::vector<uint32_t> m_block_point_segments;
+
+        /// Number of reference points in the last assignment
+        size_t m_number_points { 0 };
+
+}; // End of Fitness_Engine Class
@@ -0,0 +1,149 @@
+/**
+ * @file    Flat_Hash_Set.hpp
+ * @author  Marvin Smith
+ * @date    1/14/2021
+ */
+#pragma once
+
+// C++ Libraries
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class Flat_Hash_Set
+ * @brief Open-addressing set of 64-bit hashes.
+ *
+ * Keys are expected to already be well mixed (e.g. WaypointList::Get_Hash), so
+ * they index the table directly with linear probing.  The slot array is kept
+ * between Reset calls, so a set reused every generation stops allocating once
+ * it has seen the largest population.
+ */
+class Flat_Hash_Set
+{
+    public:
+
+        /**
+         * @brief Empty the set and size it for the expected number of keys
+         */
+        void Reset( size_t expected_size )
+        {
+            size_t capacity = 16;
+            while( capacity < 2 * expected_size )
+            {
+                capacity *= 2;
+            }
+            m_slots.assign( capacity, EMPTY_KEY );
+            m_has_empty_key = false;
+            m_size = 0;
+        }
+
+        /**
+         * @brief Insert a key
+         * @return True if the key was not already present
+         */
+        bool Insert( uint64_t key )
+        {
+            if( key == EMPTY_KEY )
+            {
+                bool inserted = !m_has_empty_key;
+                m_size += inserted ? 1 : 0;
+                m_has_empty_key = true;
+                return inserted;
+            }
+
+            // Keep the table at most half full
+            if( 2 * ( m_size + 1 ) > m_slots.size() )
+            {
+                Grow();
+            }
+
+            const size_t mask = m_slots.size() - 1;
+            for( size_t idx = key & mask; ; idx = ( idx + 1 ) & mask )
+            {
+                if( m_slots[idx] == EMPTY_KEY )
+                {
+                    m_slots[idx] = key;
+                    m_size++;
+                    return true;
+                }
+                if( m_slots[idx] == key )
+                {
+                    return false;
+                }
+            }
+        }
+
+        /**
+         * @brief Check if the key is in the set
+         */
+        bool Contains( uint64_t key ) const
+        {
+            if( key == EMPTY_KEY )
+            {
+                return m_has_empty_key;
+            }
+            if( m_slots.empty() )
+            {
+                return false;
+            }
+
+            const size_t mask = m_slots.size() - 1;
+            for( size_t idx = key & mask; m_slots[idx] != EMPTY_KEY; idx = ( idx + 1 ) & mask )
+            {
+                if( m_slots[idx] == key )
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * @brief Get the number of keys in the set
+         */
+        size_t Size() const
+        {
+            return m_size;
+        }
+
+    private:
+
+        /**
+         * @brief Double the table and reinsert every key
+         */
+        void Grow()
+        {
+            std::vector<uint64_t> old_slots;
+            old_slots.swap( m_slots );
+            m_slots.assign( std::max<size_t>( 16, 2 * old_slots.size() ), EMPTY_KEY );
+
+            const size_t mask = m_slots.size() - 1;
+            for( const auto& key : old_slots )
+            {
+                if( key == EMPTY_KEY )
+                {
+                    continue;
+                }
+                size_t idx = key & mask;
+                while( m_slots[idx] != EMPTY_KEY )
+                {
+                    idx = ( idx + 1 ) & mask;
+                }
+                m_slots[idx] = key;
+            }
+        }
+
+        /// Marks an unused slot (The key itself is tracked by m_has_empty_key)
+        static constexpr uint64_t EMPTY_KEY = 0;
+
+        /// Slot Table (Size is a power of two)
+        std::vector<uint64_t> m_slots;
+
+        /// Flag if EMPTY_KEY was inserted
+        bool m_has_empty_key { false };
+
+        /// Number of keys
+        size_t m_size { 0 };
+
+}; // End of Flat_Hash_Set Class
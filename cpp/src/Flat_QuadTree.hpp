@@ -0,0 +1,676 @@
+/**
+ * @file    Flat_QuadTree.hpp
+ * @author  Marvin Smith
+ * @date    1/17/2021
+*/
+#pragma once
+
+// Project Libraries
+#include "Point.hpp"
+#include "Rect.hpp"
+#include "Span.hpp"
+
+// C++ Libraries
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @class Flat_QuadTree
+ * @brief Point quad-tree with no pointers and no per-node allocations.
+ *
+ * Same Insert/Search behavior as QuadTree<QTNode>, but every node lives in one
+ * array and refers to its four children by the index of the first one.  Points
+ * only live in leaves, in fixed-size buckets of max_objects slots, stored as
+ * separate x, y and id arrays so a leaf scan walks contiguous memory.  A leaf at
+ * the max level that fills up chains on another bucket.
+ *
+ * Build loads a whole point set at once, which is cheaper than one Insert per
+ * point and lays the leaves out in Z-order.
+ */
+class Flat_QuadTree
+{
+    public:
+
+        /// Deepest level a tree can be built with (Bounds the query stack)
+        static constexpr size_t MAX_LEVELS = 32;
+
+        /**
+         * @brief Default Constructor (Empty tree with empty bounds)
+        */
+        Flat_QuadTree() : Flat_QuadTree( Rect() ){}
+
+        /**
+         * @brief Constructor
+         * @param bounds Region every point must fall inside
+         * @param max_objects Max number of points per leaf before splitting
+         * @param max_levels Max number of levels to allow
+        */
+        Flat_QuadTree( const Rect& bounds,
+                       size_t      max_objects = 5,
+                       size_t      max_levels = 5 )
+          : m_bounds( bounds ),
+            m_max_objects( std::max<size_t>( 1, max_objects ) ),
+            m_max_levels( max_levels )
+        {
+            if( m_max_levels > MAX_LEVELS )
+            {
+                throw std::invalid_argument( "Flat_QuadTree supports at most " + std::to_string( MAX_LEVELS ) + " levels" );
+            }
+            Clear();
+        }
+
+        /**
+         * @brief Insert a point
+         * @param id Caller's identifier for the point (Returned by Search)
+         * @param point Location, must be inside the tree bounds
+        */
+        void Insert( size_t       id,
+                     const Point& point )
+        {
+            if( !m_bounds.Is_Inside( point ) )
+            {
+                throw std::invalid_argument("Region is not inside container. Point: " + point.To_String());
+            }
+
+            // Walk down to the leaf, splitting it first if it is full
+            int32_t node_idx = 0;
+            while( true )
+            {
+                if( m_nodes[node_idx].first_child >= 0 )
+                {
+                    node_idx = m_nodes[node_idx].first_child + Get_Child_Offset( m_nodes[node_idx], point.x(), point.y() );
+                    continue;
+                }
+                if( m_nodes[node_idx].count >= m_max_objects && m_nodes[node_idx].level < m_max_levels )
+                {
+                    Split( node_idx );
+                    continue;
+                }
+                break;
+            }
+            Append( node_idx, id, point.x(), point.y() );
+            m_size++;
+        }
+
+        /**
+         * @brief Replace the contents with a point set, in one pass
+         *
+         * Point indices are put in Z-order (Morton order) by splitting them in place
+         * around each node's midpoints, one Morton digit per level (An MSD radix sort
+         * that never computes the full codes), so every subtree is a contiguous run
+         * and the tree is built top-down without moving any point twice.  The result
+         * has the same nodes as inserting the points one by one.
+         *
+         * @param points Points to load.  The id of each is its index in the span.
+        */
+        void Build( Span<const Point> points )
+        {
+            Clear();
+
+            std::vector<uint32_t> order( points.size() );
+            for( size_t idx = 0; idx < points.size(); idx++ )
+            {
+                if( !m_bounds.Is_Inside( points[idx] ) )
+                {
+                    throw std::invalid_argument("Region is not inside container. Point: " + points[idx].To_String());
+                }
+                order[idx] = idx;
+            }
+
+            // Split leaves are mostly part empty, trees come out with about four nodes (one bucket each) per max_objects points
+            const size_t expected_buckets = 5 * ( points.size() / m_max_objects + 1 );
+            m_nodes.reserve( expected_buckets );
+            m_bucket_next.reserve( expected_buckets );
+            m_xs.reserve( expected_buckets * m_max_objects );
+            m_ys.reserve( expected_buckets * m_max_objects );
+            m_ids.reserve( expected_buckets * m_max_objects );
+
+            Build_Node( 0, points, order.data(), order.data() + order.size() );
+            m_size = points.size();
+        }
+
+        /**
+         * @brief Remove every point, keeping the allocated storage
+        */
+        void Clear()
+        {
+            m_nodes.clear();
+            m_bucket_next.clear();
+            m_xs.clear();
+            m_ys.clear();
+            m_ids.clear();
+            m_free_buckets.clear();
+            m_size = 0;
+
+            Node root;
+            root.min_x = m_bounds.BL().x();
+            root.min_y = m_bounds.BL().y();
+            root.max_x = m_bounds.TR().x();
+            root.max_y = m_bounds.TR().y();
+            root.bucket = New_Bucket();
+            m_nodes.push_back( root );
+        }
+
+        /**
+         * @brief Search for all points closer than radius to the center
+         * @return Ids of the matching points
+        */
+        std::vector<size_t> Search( const Point& center_coord,
+                                    double       radius ) const
+        {
+            std::vector<size_t> output;
+            For_Each_Within( center_coord, radius, [&]( size_t id ){
+                output.push_back( id );
+            });
+            return output;
+        }
+
+        /**
+         * @brief Call fn(id) for every point closer than radius to the center, without allocating
+        */
+        template <typename Function>
+        void For_Each_Within( const Point& center_coord,
+                              double       radius,
+                              Function     fn ) const
+        {
+            Visit( center_coord.x(), center_coord.y(), radius, [&]( uint32_t slot ){
+                fn( m_ids[slot] );
+                return true;
+            });
+        }
+
+        /**
+         * @brief Check if any point is closer than radius to the center, stopping at the first one
+        */
+        bool Any_Within( const Point& center_coord,
+                         double       radius ) const
+        {
+            return !Visit( center_coord.x(), center_coord.y(), radius, []( uint32_t ){
+                return false;
+            });
+        }
+
+        /**
+         * @brief Find the closest point to the center (Ties go to the lowest id)
+         * @return Id of the closest point
+         * @throws std::runtime_error if the tree is empty
+        */
+        size_t Nearest( const Point& center_coord ) const
+        {
+            if( m_size == 0 )
+            {
+                throw std::runtime_error( "Nearest called on an empty Flat_QuadTree" );
+            }
+            const double x = center_coord.x();
+            const double y = center_coord.y();
+            double best_distance2 = std::numeric_limits<double>::max();
+            size_t best_id = 0;
+
+            // Depth-first, closest child first, skipping boxes farther than the best point so far
+            std::array<int32_t,3*MAX_LEVELS+4> stack;
+            size_t stack_size = 0;
+            stack[stack_size++] = 0;
+            while( stack_size > 0 )
+            {
+                const auto& node = m_nodes[stack[--stack_size]];
+                if( Get_Box_Distance2( node, x, y ) > best_distance2 )
+                {
+                    continue;
+                }
+
+                if( node.first_child >= 0 )
+                {
+                    std::array<std::pair<double,int32_t>,4> children;
+                    for( int32_t child = 0; child < 4; child++ )
+                    {
+                        children[child] = std::make_pair( Get_Box_Distance2( m_nodes[node.first_child + child], x, y ),
+                                                          node.first_child + child );
+                    }
+                    std::sort( children.begin(), children.end(), std::greater<>() );
+                    for( const auto& child : children )
+                    {
+                        stack[stack_size++] = child.second;
+                    }
+                    continue;
+                }
+
+                For_Each_Slot( node, [&]( uint32_t slot ){
+                    double px = m_xs[slot] - x;
+                    double py = m_ys[slot] - y;
+                    double distance2 = px * px + py * py;
+                    if( distance2 < best_distance2 || ( distance2 == best_distance2 && m_ids[slot] < best_id ) )
+                    {
+                        best_distance2 = distance2;
+                        best_id = m_ids[slot];
+                    }
+                    return true;
+                });
+            }
+            return best_id;
+        }
+
+        /**
+         * @brief Find the k closest points to the center
+         * @return Ids of up to k points, closest first (Ties go to the lowest id)
+        */
+        std::vector<size_t> Nearest_K( const Point& center_coord,
+                                       size_t       k ) const
+        {
+            std::vector<size_t> output;
+            if( k == 0 || m_size == 0 )
+            {
+                return output;
+            }
+            const double x = center_coord.x();
+            const double y = center_coord.y();
+
+            // Best-first over nodes, closest box first.  Once that box is farther than the
+            // k-th best point, nothing left in the queue can make the list.
+            typedef std::pair<double,int32_t> node_entry_t;
+            typedef std::pair<double,size_t>  point_entry_t;
+            std::priority_queue<node_entry_t,std::vector<node_entry_t>,std::greater<node_entry_t>> nodes;
+            std::priority_queue<point_entry_t> best;
+            nodes.emplace( Get_Box_Distance2( m_nodes[0], x, y ), 0 );
+            while( !nodes.empty() )
+            {
+                const auto [box_distance2, node_idx] = nodes.top();
+                nodes.pop();
+                if( best.size() == k && box_distance2 > best.top().first )
+                {
+                    break;
+                }
+
+                const auto& node = m_nodes[node_idx];
+                if( node.first_child >= 0 )
+                {
+                    for( int32_t child = 0; child < 4; child++ )
+                    {
+                        nodes.emplace( Get_Box_Distance2( m_nodes[node.first_child + child], x, y ),
+                                       node.first_child + child );
+                    }
+                    continue;
+                }
+
+                For_Each_Slot( node, [&]( uint32_t slot ){
+                    double px = m_xs[slot] - x;
+                    double py = m_ys[slot] - y;
+                    point_entry_t candidate( px * px + py * py, m_ids[slot] );
+                    if( best.size() < k )
+                    {
+                        best.push( candidate );
+                    }
+                    else if( candidate < best.top() )
+                    {
+                        best.pop();
+                        best.push( candidate );
+                    }
+                    return true;
+                });
+            }
+
+            // The heap holds the farthest on top
+            output.resize( best.size() );
+            for( size_t idx = output.size(); idx > 0; idx-- )
+            {
+                output[idx-1] = best.top().second;
+                best.pop();
+            }
+            return output;
+        }
+
+        /**
+         * @brief Get the number of points
+        */
+        size_t Size() const
+        {
+            return m_size;
+        }
+
+        /**
+         * @brief Get the number of nodes (Leaves and branches)
+        */
+        size_t Get_Number_Nodes() const
+        {
+            return m_nodes.size();
+        }
+
+        /**
+         * @brief Get the bounds
+        */
+        Rect Get_Bounds() const
+        {
+            return m_bounds;
+        }
+
+        /**
+         * @brief Print the node structure
+        */
+        std::string To_String() const
+        {
+            std::stringstream sout;
+            To_String( 0, "Root", sout );
+            return sout.str();
+        }
+
+    private:
+
+        /// One node.  Branches have children, leaves have points.
+        struct Node
+        {
+            double min_x { 0 };
+            double min_y { 0 };
+            double max_x { 0 };
+            double max_y { 0 };
+
+            /// Index of the first of four children, in CHILD_* order (-1 for leaves)
+            int32_t first_child { -1 };
+
+            /// First point bucket (Leaves only)
+            int32_t bucket { -1 };
+
+            /// Number of points (Leaves only)
+            uint32_t count { 0 };
+
+            uint32_t level { 0 };
+        };
+
+        /**
+         * @brief Visit the slot of every point closer than radius, until fn returns false
+         * @return False if fn stopped the walk
+        */
+        template <typename Visitor>
+        bool Visit( double   x,
+                    double   y,
+                    double   radius,
+                    Visitor  fn ) const
+        {
+            const double radius2 = radius * radius;
+
+            // Depth-first with a fixed stack: each level pushes at most four siblings after popping one
+            std::array<int32_t,3*MAX_LEVELS+4> stack;
+            size_t stack_size = 0;
+            stack[stack_size++] = 0;
+            while( stack_size > 0 )
+            {
+                const auto& node = m_nodes[stack[--stack_size]];
+
+                // Skip nodes whose box is not closer than the radius
+                if( Get_Box_Distance2( node, x, y ) >= radius2 )
+                {
+                    continue;
+                }
+
+                if( node.first_child >= 0 )
+                {
+                    for( int32_t child = 0; child < 4; child++ )
+                    {
+                        stack[stack_size++] = node.first_child + child;
+                    }
+                    continue;
+                }
+
+                const bool keep_going = For_Each_Slot( node, [&]( uint32_t slot ){
+                    double px = m_xs[slot] - x;
+                    double py = m_ys[slot] - y;
+                    return px * px + py * py >= radius2 || fn( slot );
+                });
+                if( !keep_going )
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * @brief Call fn(slot) for every point in a leaf, until fn returns false
+         * @return False if fn stopped the scan
+        */
+        template <typename Function>
+        bool For_Each_Slot( const Node& node,
+                            Function    fn ) const
+        {
+            uint32_t remaining = node.count;
+            for( int32_t bucket = node.bucket; remaining > 0; bucket = m_bucket_next[bucket] )
+            {
+                const uint32_t start = bucket * m_max_objects;
+                const uint32_t stop  = start + std::min<uint32_t>( remaining, m_max_objects );
+                for( uint32_t slot = start; slot < stop; slot++ )
+                {
+                    if( !fn( slot ) )
+                    {
+                        return false;
+                    }
+                }
+                remaining -= stop - start;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Get the squared distance from a point to a node's box (0 inside)
+        */
+        static double Get_Box_Distance2( const Node& node,
+                                         double      x,
+                                         double      y )
+        {
+            double dx = std::max( 0.0, std::max( node.min_x - x, x - node.max_x ) );
+            double dy = std::max( 0.0, std::max( node.min_y - y, y - node.max_y ) );
+            return dx * dx + dy * dy;
+        }
+
+        /**
+         * @brief Get which child (CHILD_*) a point belongs to.  Points on the center lines go north-west, like QuadTree.
+        */
+        static int32_t Get_Child_Offset( const Node& node,
+                                         double      x,
+                                         double      y )
+        {
+            const bool west  = x <= 0.5 * ( node.min_x + node.max_x );
+            const bool north = y >= 0.5 * ( node.min_y + node.max_y );
+            if( north )
+            {
+                return west ? CHILD_NW : CHILD_NE;
+            }
+            return west ? CHILD_SW : CHILD_SE;
+        }
+
+        /**
+         * @brief Get the box of one child (CHILD_*) of a node
+        */
+        static Node Get_Child_Node( const Node& parent,
+                                    int32_t     child )
+        {
+            const double center_x = 0.5 * ( parent.min_x + parent.max_x );
+            const double center_y = 0.5 * ( parent.min_y + parent.max_y );
+            const bool west  = ( child == CHILD_NW || child == CHILD_SW );
+            const bool north = ( child == CHILD_NW || child == CHILD_NE );
+
+            Node node;
+            node.min_x = west  ? parent.min_x : center_x;
+            node.max_x = west  ? center_x : parent.max_x;
+            node.min_y = north ? center_y : parent.min_y;
+            node.max_y = north ? parent.max_y : center_y;
+            node.level = parent.level + 1;
+            return node;
+        }
+
+        /**
+         * @brief Fill a node from a run of point indices, splitting the run between its children if it holds too many
+        */
+        void Build_Node( int32_t           node_idx,
+                         Span<const Point> points,
+                         uint32_t*         begin,
+                         uint32_t*         end )
+        {
+            const Node parent = m_nodes[node_idx];
+            if( (size_t)( end - begin ) <= m_max_objects || parent.level >= m_max_levels )
+            {
+                for( auto idx = begin; idx != end; idx++ )
+                {
+                    Append( node_idx, *idx, points[*idx].x(), points[*idx].y() );
+                }
+                return;
+            }
+
+            // Split the run into the CHILD_* order (NE, NW, SW, SE) with the same tests as Get_Child_Offset
+            const double center_x = 0.5 * ( parent.min_x + parent.max_x );
+            const double center_y = 0.5 * ( parent.min_y + parent.max_y );
+            auto south_begin = std::partition( begin, end, [&]( uint32_t idx ){ return points[idx].y() >= center_y; } );
+            auto nw_begin    = std::partition( begin, south_begin, [&]( uint32_t idx ){ return !( points[idx].x() <= center_x ); } );
+            auto se_begin    = std::partition( south_begin, end, [&]( uint32_t idx ){ return points[idx].x() <= center_x; } );
+
+            const int32_t first_child = Add_Children( node_idx );
+            Build_Node( first_child + CHILD_NE, points, begin,       nw_begin );
+            Build_Node( first_child + CHILD_NW, points, nw_begin,    south_begin );
+            Build_Node( first_child + CHILD_SW, points, south_begin, se_begin );
+            Build_Node( first_child + CHILD_SE, points, se_begin,    end );
+        }
+
+        /**
+         * @brief Give a leaf four empty children, releasing its bucket
+         * @return Index of the first child
+        */
+        int32_t Add_Children( int32_t node_idx )
+        {
+            const int32_t first_child = m_nodes.size();
+            const Node parent = m_nodes[node_idx];
+            for( int32_t child = 0; child < 4; child++ )
+            {
+                Node node = Get_Child_Node( parent, child );
+                node.bucket = New_Bucket();
+                m_nodes.push_back( node );
+            }
+            m_nodes[node_idx].first_child = first_child;
+            m_nodes[node_idx].bucket = -1;
+            m_nodes[node_idx].count = 0;
+            m_free_buckets.push_back( parent.bucket );
+            return first_child;
+        }
+
+        /**
+         * @brief Turn a leaf into a branch, moving its points down
+        */
+        void Split( int32_t node_idx )
+        {
+            const Node parent = m_nodes[node_idx];
+            const int32_t first_child = Add_Children( node_idx );
+
+            // The released bucket is only reused by a later New_Bucket, so its points can still be read here.
+            // Split leaves are never at the max level, so they only ever have one bucket
+            const uint32_t start = parent.bucket * m_max_objects;
+            for( uint32_t slot = start; slot < start + parent.count; slot++ )
+            {
+                int32_t child = first_child + Get_Child_Offset( parent, m_xs[slot], m_ys[slot] );
+                Append( child, m_ids[slot], m_xs[slot], m_ys[slot] );
+            }
+        }
+
+        /**
+         * @brief Add a point to the end of a leaf, chaining a bucket if the last one is full
+        */
+        void Append( int32_t  node_idx,
+                     size_t   id,
+                     double   x,
+                     double   y )
+        {
+            int32_t bucket = m_nodes[node_idx].bucket;
+            uint32_t position = m_nodes[node_idx].count;
+            while( position >= m_max_objects )
+            {
+                if( m_bucket_next[bucket] < 0 )
+                {
+                    int32_t next = New_Bucket();
+                    m_bucket_next[bucket] = next;
+                }
+                bucket = m_bucket_next[bucket];
+                position -= m_max_objects;
+            }
+
+            const uint32_t slot = bucket * m_max_objects + position;
+            m_xs[slot]  = x;
+            m_ys[slot]  = y;
+            m_ids[slot] = id;
+            m_nodes[node_idx].count++;
+        }
+
+        /**
+         * @brief Get an empty bucket, reusing one freed by a split if possible
+        */
+        int32_t New_Bucket()
+        {
+            if( !m_free_buckets.empty() )
+            {
+                int32_t bucket = m_free_buckets.back();
+                m_free_buckets.pop_back();
+                m_bucket_next[bucket] = -1;
+                return bucket;
+            }
+            m_bucket_next.push_back( -1 );
+            m_xs.resize( m_xs.size() + m_max_objects );
+            m_ys.resize( m_ys.size() + m_max_objects );
+            m_ids.resize( m_ids.size() + m_max_objects );
+            return m_bucket_next.size() - 1;
+        }
+
+        /**
+         * @brief Print one node and everything below it
+        */
+        void To_String( int32_t            node_idx,
+                        const std::string& layer,
+                        std::stringstream& sout ) const
+        {
+            const auto& node = m_nodes[node_idx];
+            std::string gap( 4 * node.level, ' ' );
+            sout << gap << "Flat_QuadTree: " << layer << ", Level: " << node.level << ", Points: " << node.count
+                 << ", BBOX: " << Rect( ToPoint2D( node.min_x, node.min_y ), ToPoint2D( node.max_x, node.max_y ) ).To_String() << std::endl;
+            if( node.first_child >= 0 )
+            {
+                To_String( node.first_child + CHILD_NE, "NE", sout );
+                To_String( node.first_child + CHILD_NW, "NW", sout );
+                To_String( node.first_child + CHILD_SW, "SW", sout );
+                To_String( node.first_child + CHILD_SE, "SE", sout );
+            }
+        }
+
+        // Child order, same as QuadTree
+        static constexpr int32_t CHILD_NE = 0;
+        static constexpr int32_t CHILD_NW = 1;
+        static constexpr int32_t CHILD_SW = 2;
+        static constexpr int32_t CHILD_SE = 3;
+
+        // Bounds
+        Rect m_bounds;
+
+        /// Max Number of Points per Leaf (Also the bucket size)
+        uint32_t m_max_objects;
+
+        /// Max Number of Levels
+        uint32_t m_max_levels;
+
+        /// Nodes, root first.  Siblings are always adjacent.
+        std::vector<Node> m_nodes;
+
+        /// Next bucket in a leaf's chain (-1 for the last one)
+        std::vector<int32_t> m_bucket_next;
+
+        /// Point slots, m_max_objects per bucket
+        std::vector<double> m_xs;
+        std::vector<double> m_ys;
+        std::vector<size_t> m_ids;
+
+        /// Buckets released by splits
+        std::vector<int32_t> m_free_buckets;
+
+        /// Number of points
+        size_t m_size { 0 };
+
+}; // End of Flat_QuadTree Class
@@ -5,6 +5,10 @@
  */
 #pragma once
 
+// C++ Libraries
+#include <cstdint>
+#include <string>
+
 struct GA_Config
 {
     double preservation_rate { 0.01 };
@@ -13,4 +17,7 @@ struct GA_Config
     double random_vert_rate { 0.05 };
     std::string stats_output_pathname { "./ga_run_stats" };
     size_t number_threads { 1 };
+    size_t fitness_cache_size { 1 << 16 };
+    size_t tournament_size { 0 };
+    uint64_t random_seed { 0 };
 }; // End of GA_Config Class
\ No newline at end of file
@@ -7,11 +7,18 @@
 
 // C++ Libraries
 #include <algorithm>
+#include <cstdint>
 #include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
 
 // Project Libraries
 #include "GA_Config.hpp"
 #include "Exit_Condition.hpp"
+#include "Fitness_Cache.hpp"
+#include "Flat_Hash_Set.hpp"
+#include "Random.hpp"
 #include "Stats_Aggregator.hpp"
 #include "Thread_Pool.hpp"
 #include "WaypointList.hpp" // REMOVE ME!
@@ -28,34 +35,70 @@ class Genetic_Algorithm
          * @brief Constructor
          * @param config Configuration of the GA
          * @param population Initial population sample
+         * @param crossover_algorithm Writes the child of the first two arguments into the third
+         * @note Every operator draws from the Random_Generator it is handed.  Those are derived from
+         *       config.random_seed, the generation and the population index, so a run gives the same
+         *       result for the same seed whatever the thread count.
+         * @param thread_pool Shared worker pool for offspring generation and the fitness passes
          */
         Genetic_Algorithm( const GA_Config&                              config,
                            std::vector<Phenotype>                        population,
-                           std::function<Phenotype(const Phenotype&, 
-                                                   const Phenotype&)>    crossover_algorithm,
-                           std::function<void(Phenotype&)>               mutation_algorithm,
-                           std::function<void(Phenotype&)>               random_algorithm,
+                           std::function<void(const Phenotype&,
+                                              const Phenotype&,
+                                              Phenotype&,
+                                              Random_Generator&)>        crossover_algorithm,
+                           std::function<void(Phenotype&,
+                                              Random_Generator&)>        mutation_algorithm,
+                           std::function<void(Phenotype&,
+                                              Random_Generator&)>        random_algorithm,
                            std::function<void(const Phenotype&, 
                                               const std::string& string, 
                                               size_t)>                   write_worker,
-                           Stats_Aggregator&                             stats_aggregator )
+                           Stats_Aggregator&                             stats_aggregator,
+                           Thread_Pool&                                  thread_pool )
           : m_config( config ),
-            m_population(population),
+            m_population(std::move(population)),
+            m_next_population(m_population),
+            m_states(m_population.size()),
+            m_next_states(m_population.size()),
             m_crossover_algorithm(crossover_algorithm),
             m_mutation_algorithm(mutation_algorithm),
             m_random_algorithm(random_algorithm),
             m_write_worker(write_worker),
-            m_aggregator(stats_aggregator)
+            m_aggregator(stats_aggregator),
+            m_thread_pool(thread_pool),
+            m_fitness_cache(config.fitness_cache_size)
         {
         }
 
+        /// Context Type shared with the Phenotype Fitness Method
+        typedef typename Phenotype::context_tp context_tp;
+
+        /// Fitness State the Phenotype leaves behind for scoring its relatives
+        typedef typename Phenotype::Fitness_State fitness_state_tp;
+
+        /**
+         * @brief Get the number of generations the last Run went through
+         * @note Less than max_iterations if the exit condition ended the run early.
+         */
+        size_t Get_Number_Iterations() const
+        {
+            return m_number_iterations;
+        }
+
         /**
          * @brief Run the GA
+         * @param sector_id Sector name used for logging
+         * @param context Shared, read-only data used by the fitness method
+         * @param max_iterations Max number of generations
+         * @param exit_condition Early exit check
+         * @return Final population, best first
+         * @note The population is moved out, so Run can only be called once.
          */
-        std::vector<Phenotype> Run( const std::string&    sector_id,
-                                    int                   max_iterations = 1000,
-                                    Exit_Condition::ptr_t exit_condition = std::make_shared<Exit_Condition>(),
-                                    void*                 context_info   = nullptr )
+        std::vector<Phenotype> Run( const std::string&                sector_id,
+                                    std::shared_ptr<const context_tp> context,
+                                    int                               max_iterations = 1000,
+                                    Exit_Condition::ptr_t             exit_condition = std::make_shared<Exit_Condition>() )
         {
             // Compute the key population subset sizes
             size_t selection_size    = m_config.selection_rate * m_population.size();
@@ -71,6 +114,7 @@ class Genetic_Algorithm
                 sout << "Selection Size    : " << selection_size << ", Rate: " << m_config.selection_rate << std::endl;
                 sout << "Mutation Size     : " << mutation_size << ", Rate: " << m_config.mutation_rate << std::endl;
                 sout << "Crossover Size    : " << m_population.size() - (preservation_size + selection_size) << std::endl;
+                sout << "Tournament Size   : " << m_config.tournament_size << " (0 = Truncation Selection)" << std::endl;
                 BOOST_LOG_TRIVIAL(debug) << "Sector: " << sector_id << ", " << sout.str();
             }
 
@@ -80,82 +124,128 @@ class Genetic_Algorithm
                 assert( p.Get_DNA().size() == p.Get_DNA_Expected_Size( ) );
             }
 
+            // Selection works through the ranking.  Genomes only move when a generation is swapped in.
+            m_ranking.resize( m_population.size() );
+            for( size_t idx = 0; idx < m_population.size(); idx++ )
+            {
+                m_ranking[idx].second = idx;
+            }
+            m_thread_pool.parallel_for( 0, m_population.size(), 0, [&]( size_t idx ){
+                Update_Fitness( m_population[idx], *context, m_population[idx], m_states[idx] );
+            });
+            Update_Ranking( preservation_size,
+                            ( m_config.tournament_size > 0 ) ? preservation_size : preservation_size + selection_size );
+
+            // Mutations are spread evenly over everything but the preserved set
+            const double mutations_per_member = mutation_size / (double)std::max<size_t>( 1, m_population.size() - preservation_size );
+
             // Run the iterations
+            m_number_iterations = 0;
             for( int iteration = 0; iteration < max_iterations; iteration++ )
             {
                 assert( expected_population_size == m_population.size() );
                 BOOST_LOG_TRIVIAL(debug) << "Starting Iteration " << iteration << " of " << max_iterations;
                 auto start_loop_time = std::chrono::steady_clock::now();
 
-                // Define a subset for Selection
+                // Define a subset for Selection (Ranks, not population indices)
                 auto selectionStartIdx = preservation_size;
                 auto selectionStopIdx  = preservation_size + selection_size;
 
-                // Run Crossover on random pairs
-                for( int cidx = selectionStopIdx; cidx < m_population.size(); cidx++ )
-                {
-                    // Pick Crossover indices from the selection range
-                    size_t idx1 = rand() % selectionStopIdx;
-                    size_t idx2 = rand() % selectionStopIdx;
-                    while( idx1 == idx2 )
+                // Each child is selected, crossed over, mutated and scored by one task, straight into the
+                // spare buffer.  Every task has its own generator, so the result does not depend on the worker.
+                BOOST_LOG_TRIVIAL(debug) << "Starting Offspring Generation. Threads: " << m_thread_pool.size();
+                auto start_offspring = std::chrono::steady_clock::now();
+                const uint64_t generation_seed = Random_Generator::Derive_Seed( m_config.random_seed, iteration );
+                const size_t number_survivors = ( m_config.tournament_size > 0 ) ? preservation_size : selectionStopIdx;
+                m_thread_pool.parallel_for( number_survivors, m_population.size(), 0, [&]( size_t cidx ){
+                    Random_Generator rng( generation_seed, cidx );
+                    size_t idx1, idx2;
+                    if( m_config.tournament_size > 0 )
                     {
-                        idx2 = (rand() % selectionStopIdx - selectionStartIdx) + selectionStartIdx;
+                        // Parents are tournament winners from the whole population
+                        idx1 = Run_Tournament( rng );
+                        idx2 = Run_Tournament( rng );
                     }
-                    m_population[cidx] = m_crossover_algorithm( m_population[idx1],
-                                                                m_population[idx2] );
-                }
+                    else
+                    {
+                        // Pick Crossover indices from the selection range
+                        idx1 = rng.Uniform( selectionStopIdx );
+                        idx2 = rng.Uniform( selectionStopIdx );
+                        while( idx1 == idx2 && selectionStopIdx > 1 )
+                        {
+                            idx2 = rng.Uniform( selectionStopIdx );
+                        }
+                        idx1 = Ranked_Index( idx1 );
+                        idx2 = Ranked_Index( idx2 );
+                    }
+
+                    auto& child = m_next_population[cidx];
+                    m_crossover_algorithm( m_population[idx1],
+                                           m_population[idx2],
+                                           child,
+                                           rng );
+                    Mutate( child, mutations_per_member, rng );
+
+                    // Start from the assignment of whichever parent the child is closer to
+                    const size_t relative = ( child.Count_Moved_Waypoints( m_population[idx2] ) <
+                                              child.Count_Moved_Waypoints( m_population[idx1] ) ) ? idx2 : idx1;
+                    m_next_states[cidx] = m_states[relative];
+                    Update_Fitness( child, *context, m_population[relative], m_next_states[cidx] );
+                });
 
-                // Run Mutation
-                auto start_mutation = std::chrono::steady_clock::now();
-                for( size_t midx = 0; midx < mutation_size; midx++ )
+                // Survivors swap over in rank order, then the buffers trade places
+                for( size_t rank = 0; rank < number_survivors; rank++ )
                 {
-                    // Do not run mutation on the preservation set!
-                    size_t mutationIdx = rand() % (m_population.size() - selectionStartIdx) + selectionStartIdx;
-                    m_mutation_algorithm( m_population[mutationIdx] ); 
+                    std::swap( m_next_population[rank], m_population[Ranked_Index( rank )] );
+                    std::swap( m_next_states[rank], m_states[Ranked_Index( rank )] );
                 }
-                auto mutation_time = std::chrono::duration_cast<std::chrono::milliseconds>( std::chrono::steady_clock::now() - start_mutation ).count()/1000.0;
-                m_aggregator.Report_Timing( "Mutation", mutation_time );
-
-                // Update Fitness Scores
-                BOOST_LOG_TRIVIAL(debug) << "Starting Fitness Computations. Threads: " << m_config.number_threads;
-                auto start_fitness = std::chrono::steady_clock::now();
+                m_population.swap( m_next_population );
+                m_states.swap( m_next_states );
+                for( size_t idx = 0; idx < m_ranking.size(); idx++ )
                 {
-                    Thread_Pool pool( m_config.number_threads );
-                    for( auto& member : m_population )
-                    {
-                        pool.enqueue_work([&]() {
-                            member.Update_Fitness( context_info,
-                                                   false,
-                                                   m_aggregator );
-                        });
-                    }
-                    auto fitness_time = std::chrono::duration_cast<std::chrono::milliseconds>( std::chrono::steady_clock::now() - start_fitness ).count()/1000.0;
-                    m_aggregator.Report_Timing( "Initial Fitness Jobs", fitness_time );
+                    m_ranking[idx].second = idx;
                 }
-                auto fitness_time = std::chrono::duration_cast<std::chrono::milliseconds>( std::chrono::steady_clock::now() - start_fitness ).count()/1000.0;
-                m_aggregator.Report_Timing( "Initial Fitness Full", fitness_time );
+
+                // Surviving parents get their share of mutations too (Never the preserved set).
+                // The spare slot keeps the member as it was, so only the mutated segments get rescored.
+                m_thread_pool.parallel_for( selectionStartIdx, number_survivors, 0, [&]( size_t idx ){
+                    Random_Generator rng( generation_seed, idx );
+                    m_next_population[idx] = m_population[idx];
+                    Mutate( m_population[idx], mutations_per_member, rng );
+                    Update_Fitness( m_population[idx], *context, m_next_population[idx], m_states[idx] );
+                });
+                auto offspring_time = std::chrono::duration_cast<std::chrono::milliseconds>( std::chrono::steady_clock::now() - start_offspring ).count()/1000.0;
+                m_aggregator.Report_Timing( "Offspring Full", offspring_time );
 
                 //////////////////////////////////////////////////////
                 //////////////////////////////////////////////////////
-                // Randomize Unique Entries (No point in crossing-over yourself over and over)
+                // Randomize Duplicate Entries (No point in crossing-over yourself over and over)
                 #if 1
                 auto start_unique = std::chrono::steady_clock::now();
-                std::sort( m_population.begin(), m_population.end() );
-                auto end_of_unique_iter = std::unique( m_population.begin(), m_population.end() );
 
-                // For the duplicates, create random entries
+                // The first copy of each genome in rank order is kept, so the preserved set is never touched
                 size_t number_duplicates = 0;
-                for( ; end_of_unique_iter != m_population.end(); end_of_unique_iter++ )
+                Random_Generator rng( generation_seed, m_population.size() );
+                m_genome_hashes.Reset( m_population.size() );
+                for( size_t rank = 0; rank < m_population.size(); rank++ )
                 {
+                    auto& member = m_population[Ranked_Index( rank )];
+                    if( m_genome_hashes.Insert( member.Get_Hash() ) )
+                    {
+                        continue;
+                    }
+
+                    // For the duplicates, create random entries
                     number_duplicates++;
-                    if( rand()%2 == 0 )
+                    if( rng.Uniform( 2 ) == 0 )
                     {
-                        m_random_algorithm( *end_of_unique_iter );
+                        m_random_algorithm( member, rng );
                     }
                     else
                     {
-                        size_t rvidx = rand() % selectionStopIdx;
-                        end_of_unique_iter->Randomize_Vertices( m_population[rvidx] );
+                        // Shuffle a survivor (Only the preserved set survives in tournament mode)
+                        size_t rvidx = rng.Uniform( number_survivors );
+                        member.Randomize_Vertices( m_population[Ranked_Index( rvidx )], rng );
                     }
                 }
                 m_aggregator.Report_Duplicate_Entry( sector_id,
@@ -168,76 +258,222 @@ class Genetic_Algorithm
                 m_aggregator.Report_Timing( "Unique Full", unique_time );
 
                 // Update Fitness Scores
-                start_fitness = std::chrono::steady_clock::now();
-                {
-                    Thread_Pool pool;
-                    for( auto& member : m_population )
-                    {
-                        pool.enqueue_work([&]() {
-                           member.Update_Fitness( context_info,
-                                                  true,
-                                                  m_aggregator );
-                        });
-                    }
-                    fitness_time = std::chrono::duration_cast<std::chrono::milliseconds>( std::chrono::steady_clock::now() - start_fitness ).count()/1000.0;
-                    m_aggregator.Report_Timing( "Second Fitness Jobs", fitness_time );
-                }
+                auto start_fitness = std::chrono::steady_clock::now();
+                m_thread_pool.parallel_for( 0, m_population.size(), 0, [&]( size_t idx ){
+                    Update_Fitness( m_population[idx], *context, m_population[idx], m_states[idx] );
+                });
+                auto fitness_time = std::chrono::duration_cast<std::chrono::milliseconds>( std::chrono::steady_clock::now() - start_fitness ).count()/1000.0;
                 m_aggregator.Report_Timing( "Second Fitness Full", fitness_time );
                 #endif
                 //////////////////////////////////////////////////////
                 //////////////////////////////////////////////////////
 
-                // Sort the population one last time
-                std::sort( m_population.begin(), m_population.end() );
+                // Rank the population for the next generation
+                auto start_rank = std::chrono::steady_clock::now();
+                Update_Ranking( preservation_size,
+                                ( m_config.tournament_size > 0 ) ? preservation_size : selectionStopIdx );
+                auto rank_time = std::chrono::duration_cast<std::chrono::microseconds>( std::chrono::steady_clock::now() - start_rank ).count()/1000000.0;
+                m_aggregator.Report_Timing( "Ranking", rank_time );
+                const auto& best = m_population[Ranked_Index( 0 )];
 
-                BOOST_LOG_TRIVIAL(debug) << "Sector: " << sector_id << ", Iteration: " << iteration << ", Current Best Matches: " << Print_Population_List( m_population, 10 );
+                BOOST_LOG_TRIVIAL(debug) << "Sector: " << sector_id << ", Iteration: " << iteration << ", Current Best Matches: " << Print_Population_List( Get_Ranked_Population( 10 ) );
 
                 auto iter_time_ms = std::chrono::duration_cast<std::chrono::milliseconds>( std::chrono::steady_clock::now() - start_loop_time );
                 m_aggregator.Report_Iteration_Complete( sector_id,
-                                                        m_population.front().Get_Number_Waypoint(), 
+                                                        best.Get_Number_Waypoint(), 
                                                         iteration,
-                                                        m_population.front().Get_Fitness(),
+                                                        best.Get_Fitness(),
                                                         iter_time_ms.count()/1000.0 );
+                m_number_iterations++;
 
                 // Check Exit Condition
-                if( exit_condition->Check_Exit( m_population.front().Get_Fitness() ) )
+                if( exit_condition->Check_Exit( best.Get_Fitness() ) )
                 {
                     break;
                 }
 
                 // Write Latest Results
                 auto start_write = std::chrono::steady_clock::now();
-                m_write_worker( m_population.front(), sector_id, iteration );
+                m_write_worker( best, sector_id, iteration );
                 auto write_time = std::chrono::duration_cast<std::chrono::milliseconds>( std::chrono::steady_clock::now() - start_write ).count()/1000.0;
                 m_aggregator.Report_Timing( "Write Worker Time", write_time );
+            }
+            m_aggregator.Report_Fitness_Cache( sector_id,
+                                               m_population.front().Get_Number_Waypoint(),
+                                               m_fitness_cache.Get_Hits(),
+                                               m_fitness_cache.Get_Misses(),
+                                               m_fitness_cache.Get_Filtered() );
 
-                // Sleep so other sectors get a chance to get started
-                std::this_thread::sleep_for( std::chrono::microseconds(50) );
+            // Hand back the population best-first (The only full sort of the run)
+            std::sort( m_ranking.begin(), m_ranking.end() );
+            for( size_t rank = 0; rank < m_ranking.size(); rank++ )
+            {
+                std::swap( m_next_population[rank], m_population[Ranked_Index( rank )] );
             }
-            return m_population;
+            return std::move( m_next_population );
         }
 
     private:
 
+        /**
+         * @brief Rank the population by fitness, only as far as selection needs
+         *
+         * Afterwards ranks [0,number_sorted) are in order, and ranks [0,number_parents)
+         * hold the best number_parents members in no particular order.  Unscored members
+         * rank last.  Ties go to the
+         * lower population index, so which members make the cut does not depend on the
+         * previous ranking.
+         */
+        void Update_Ranking( size_t number_sorted,
+                             size_t number_parents )
+        {
+            for( auto& entry : m_ranking )
+            {
+                const auto& member = m_population[entry.second];
+                entry.first = member.Is_Dirty() ? std::numeric_limits<double>::max() : member.Get_Fitness();
+            }
+            number_parents = std::min( number_parents, m_ranking.size() );
+            number_sorted  = std::max<size_t>( 1, std::min( number_sorted, number_parents ) );
+            if( number_parents < m_ranking.size() )
+            {
+                std::nth_element( m_ranking.begin(),
+                                  m_ranking.begin() + number_parents,
+                                  m_ranking.end() );
+            }
+            std::partial_sort( m_ranking.begin(),
+                               m_ranking.begin() + number_sorted,
+                               m_ranking.begin() + number_parents );
+        }
+
+        /**
+         * @brief Get the population index of the member at the given rank
+         */
+        size_t Ranked_Index( size_t rank ) const
+        {
+            return m_ranking[rank].second;
+        }
+
+        /**
+         * @brief Copy out the best members, best first
+         */
+        std::vector<Phenotype> Get_Ranked_Population( size_t count ) const
+        {
+            count = std::min( count, m_ranking.size() );
+            auto ranking = m_ranking;
+            std::partial_sort( ranking.begin(), ranking.begin() + count, ranking.end() );
+
+            std::vector<Phenotype> output;
+            output.reserve( count );
+            for( size_t rank = 0; rank < count; rank++ )
+            {
+                output.push_back( m_population[ranking[rank].second] );
+            }
+            return output;
+        }
+
+        /**
+         * @brief Pick a parent as the fittest of tournament_size random members
+         * @return Population index of the winner
+         */
+        size_t Run_Tournament( Random_Generator& rng ) const
+        {
+            size_t winner = rng.Uniform( m_population.size() );
+            for( size_t round = 1; round < m_config.tournament_size; round++ )
+            {
+                size_t challenger = rng.Uniform( m_population.size() );
+                if( m_population[challenger].Get_Fitness() < m_population[winner].Get_Fitness() )
+                {
+                    winner = challenger;
+                }
+            }
+            return winner;
+        }
+
+        /**
+         * @brief Apply mutations_per_member mutations on average (The fraction is a coin flip)
+         */
+        void Mutate( Phenotype&        member,
+                     double            mutations_per_member,
+                     Random_Generator& rng )
+        {
+            size_t count = mutations_per_member;
+            if( rng.Uniform_Real() < mutations_per_member - count )
+            {
+                count++;
+            }
+            for( size_t midx = 0; midx < count; midx++ )
+            {
+                m_mutation_algorithm( member, rng );
+            }
+        }
+
+        /**
+         * @brief Score one member, reusing the score of an identical genome if the cache has one
+         * @param relative Genome the state belongs to, if it is still valid
+         * @param state Fitness state of the relative on input, of the member once it is scored
+         * @note Members the operators have not touched since they were last scored are skipped.
+         */
+        void Update_Fitness( Phenotype&        member,
+                             const context_tp& context,
+                             const Phenotype&  relative,
+                             fitness_state_tp& state )
+        {
+            if( !member.Is_Dirty() )
+            {
+                return;
+            }
+
+            double fitness;
+            if( m_fitness_cache.Find( member.Get_Hash(), fitness ) )
+            {
+                member.Set_Fitness( fitness );
+                return;
+            }
+            member.Update_Fitness( context, relative, state, m_aggregator );
+            m_fitness_cache.Insert( member.Get_Hash(), member.Get_Fitness() );
+        }
+
         // Configuration
         GA_Config m_config;
 
         // Active Population
         std::vector<Phenotype> m_population;
 
+        // Next generation under construction (Swapped with m_population every generation)
+        std::vector<Phenotype> m_next_population;
+
+        // Fitness state per population slot, and for the generation under construction
+        std::vector<fitness_state_tp> m_states;
+        std::vector<fitness_state_tp> m_next_states;
+
         // Crossover Algorithm
-        std::function<Phenotype(const Phenotype&, const Phenotype&)> m_crossover_algorithm;
+        std::function<void(const Phenotype&, const Phenotype&, Phenotype&, Random_Generator&)> m_crossover_algorithm;
 
         // Mutation Algorithm
-        std::function<void(Phenotype&)> m_mutation_algorithm;
+        std::function<void(Phenotype&, Random_Generator&)> m_mutation_algorithm;
 
         // Random Algorithm
-        std::function<void(Phenotype&)> m_random_algorithm;
+        std::function<void(Phenotype&, Random_Generator&)> m_random_algorithm;
 
         // Intermediate Write Worker
         std::function<void(const Phenotype&, const std::string&, size_t)> m_write_worker;
 
         // Stats Aggregation Class
         Stats_Aggregator& m_aggregator;
+
+        // Shared Worker Pool
+        Thread_Pool& m_thread_pool;
+
+        // Genome hashes seen during the duplicate pass (Reused every generation)
+        Flat_Hash_Set m_genome_hashes;
+
+        // Scores of genomes already evaluated in this run
+        Fitness_Cache m_fitness_cache;
+
+        // (Fitness, Population Index) per rank.  Selection works on this instead of moving genomes.
+        std::vector<std::pair<double,uint32_t>> m_ranking;
+
+        // Generations completed by the last Run
+        size_t m_number_iterations { 0 };
         
 }; // End of Genetic_Algorithm Class
\ No newline at end of file
@@ -9,7 +9,6 @@
 #include <array>
 #include <cmath>
 #include <iostream>
-#include <map>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -21,11 +20,10 @@
 #include <boost/geometry/geometries/adapted/boost_tuple.hpp>
 
 // Project Libraries
-#include "QuadTree.hpp"
+#include "Fitness_Engine.hpp"
+#include "Flat_QuadTree.hpp"
 #include "Point.hpp"
 
-//#define PRINT_JUNK
-
 /**
  * @brief Compute the distance from the point to the line segment
  * @param p Test point
@@ -68,16 +66,14 @@ double Point_Line_Distance( const Point_<TP,Dims>& p,
 */
 template <typename TP, size_t Dims>
 double Get_Segment_Density( const std::vector<Point_<TP,Dims>>& vertices,
-                            const QuadTree<QTNode>&             quad_tree,
+                            const Flat_QuadTree&                quad_tree,
                             double                              step_distance )
 {
     double segment_pos = 0;
     double segment_length = 0;
-    bool point_found = false;
     double ratio = 0;
     uint64_t total_steps = 0;
     uint64_t steps_with_points = 1;
-    std::vector<std::shared_ptr<QTNode>> results;
 
     // For each vertex
     for( size_t i=0; i<(vertices.size()-1); i++ )
@@ -107,11 +103,8 @@ double Get_Segment_Density( const std::vector<Point_<TP,Dims>>& vertices,
             
 
             // Look for a single point within distance to this point
-            point_found = false;
-            results = quad_tree.Search( test_seg_point, step_distance );
-            if( results.size() > 0 )
+            if( quad_tree.Any_Within( test_seg_point, step_distance ) )
             {
-                 point_found = true;
                  steps_with_points++;
             }
 
@@ -130,80 +123,9 @@ template <typename TP, size_t Dims>
 double Fitness_Score_01( const std::vector<Point_<TP,Dims>>& point_list,
                          const std::vector<Point_<TP,Dims>>& vertices )
 {
-    // Compute the closest segment for all points
-    std::map<int,std::pair<size_t,double>> segment_point_mapping;
-    for( size_t point_id=0; point_id<point_list.size(); point_id++ )
-    {
-        segment_point_mapping[point_id].first = -1;
-        segment_point_mapping[point_id].second = -1;
-
-        // Iterate over all vertices, finding the nearest distance to a segment, then do it for each distance to vertex itself
-        for( size_t seg_idx=0; seg_idx<(vertices.size()-1); seg_idx++ )
-        {
-            // Compute the distance to this line segment
-            auto dist = Point_Line_Distance( point_list[point_id], 
-                                             vertices[seg_idx], 
-                                             vertices[seg_idx+1] );
-            if( segment_point_mapping[point_id].second < 0 || 
-                dist < segment_point_mapping[point_id].second )
-            {
-                segment_point_mapping[point_id].first = seg_idx;
-                segment_point_mapping[point_id].second = dist;
-            }
-        }
-        //std::cout << "Point: " << point_id << ", Closest Match: " << segment_point_mapping[point_id].first << ", Dist: " << segment_point_mapping[point_id].second << std::endl;
-    }
-
-    // For each segment, compute the density score
-    double min_segment_point_density = -1;//std::numeric_limits<double>::max(); 
-    double segment_length;
-    double total_route_len = 0;
-    double total_seg_ratio = 0;
-    double mean_seg_ratio = 0;
-    for( size_t seg_idx=0; seg_idx < (vertices.size()-1); seg_idx++ )
-    {
-        double total_point_distance = 0;
-        int    num_points_in_segment = 0;
-
-        // For each mapped point, process the distance
-        for( const auto& seg_pnt : segment_point_mapping )
-        {
-            if( seg_pnt.second.first == seg_idx )
-            {
-                total_point_distance += seg_pnt.second.second;
-                num_points_in_segment += 1;
-            }
-        }
-        
-
-        // @todo:  Consider taking average of point distance?  
-        //     Pros:
-        //     Cons:
-        //     - Sum helps penalize overly long segments
-        total_point_distance /= (num_points_in_segment+1);
-
-        // Compute "Min Segment Point Density"
-        min_segment_point_density = std::max( total_point_distance, min_segment_point_density );
-
-        // Get the Segment Length
-        segment_length = Point::Distance_L2( vertices[seg_idx],
-                                             vertices[seg_idx+1] );
-        total_route_len += segment_length;
-
-        double tsr = std::pow( segment_length / (num_points_in_segment+1), 2 );
-#ifdef PRINT_JUNK
-        std::cout << std::fixed << "TSR: " << tsr << ", Point Distance: " << total_point_distance << ", Segment: " << seg_idx << ", Length: " << segment_length << ", Num Points: " << num_points_in_segment << " of " << point_list.size() << std::endl;
-#endif
-        total_seg_ratio += tsr;
-    }
-#ifdef PRINT_JUNK    
-    std::cout << std::fixed << "Min Seg Density: " << min_segment_point_density << std::endl;
-    std::cout << "Num Points: " << point_list.size() << ", Total Length: " << std::fixed << total_route_len << std::endl;
-#endif
-    // Compute Final Score
-    double score = (point_list.size() /  total_route_len) * total_seg_ratio;
-
-    return score;
+    auto& engine = Fitness_Engine::Thread_Instance();
+    engine.Assign( point_list, vertices );
+    return engine.Score_01();
 }
 
 /**
@@ -213,68 +135,9 @@ template <typename TP, size_t Dims>
 double Fitness_Score_02( const std::vector<Point_<TP,Dims>>& point_list,
                          const std::vector<Point_<TP,Dims>>& vertices )
 {
-    // Compute the closest segment for all points
-    std::map<int,std::pair<size_t,double>> segment_point_mapping;
-    for( size_t point_id=0; point_id<point_list.size(); point_id++ )
-    {
-        segment_point_mapping[point_id].first = -1;
-        segment_point_mapping[point_id].second = -1;
-
-        // Iterate over all vertices, finding the nearest distance to a segment, then do it for each distance to vertex itself
-        for( size_t seg_idx=0; seg_idx<(vertices.size()-1); seg_idx++ )
-        {
-            // Compute the distance to this line segment
-            auto dist = Point_Line_Distance( point_list[point_id], 
-                                             vertices[seg_idx], 
-                                             vertices[seg_idx+1] );
-            if( segment_point_mapping[point_id].second < 0 || 
-                dist < segment_point_mapping[point_id].second )
-            {
-                segment_point_mapping[point_id].first = seg_idx;
-                segment_point_mapping[point_id].second = dist;
-            }
-        }
-    }
-
-    // For each segment, compute the density score
-    double segment_length;
-    double score = 0;
-    double total_length = 0;
-    for( size_t seg_idx=0; seg_idx < (vertices.size()-1); seg_idx++ )
-    {
-        double total_point_distance = 0;
-        int    num_points_in_segment = 0;
-
-        // For each mapped point, process the distance
-        for( const auto& seg_pnt : segment_point_mapping )
-        {
-            if( seg_pnt.second.first == seg_idx )
-            {
-                total_point_distance += seg_pnt.second.second;
-                num_points_in_segment += 1;
-            }
-        }
-        
-
-        // @todo:  Consider taking average of point distance?  
-        //     Pros:
-        //     Cons:
-        //     - Sum helps penalize overly long segments
-        total_point_distance = std::pow(total_point_distance / (num_points_in_segment+1), 2);
-        
-        // Get the Segment Length
-        segment_length = Point::Distance_L2( vertices[seg_idx],
-                                             vertices[seg_idx+1] );
-        total_length += segment_length;
-
-        auto fit_part = total_point_distance;
-        score += fit_part;
-#ifdef PRINT_JUNK
-        std::cout << std::fixed << "fit: " << fit_part << ", Avg Pt Dist: " << total_point_distance << ", Seg: " << seg_idx << ", Length: " << segment_length << ", Num Points: " << num_points_in_segment << " of " << point_list.size() << std::endl;
-#endif
-    }
-
-    return score;
+    auto& engine = Fitness_Engine::Thread_Instance();
+    engine.Assign( point_list, vertices );
+    return engine.Score_02();
 }
 
 /**
@@ -284,66 +147,7 @@ template <typename TP, size_t Dims>
 double Fitness_Score_03( const std::vector<Point_<TP,Dims>>& point_list,
                          const std::vector<Point_<TP,Dims>>& vertices )
 {
-    // Compute the closest segment for all points
-    std::map<int,std::pair<size_t,double>> segment_point_mapping;
-    for( size_t point_id=0; point_id<point_list.size(); point_id++ )
-    {
-        segment_point_mapping[point_id].first = -1;
-        segment_point_mapping[point_id].second = -1;
-
-        // Iterate over all vertices, finding the nearest distance to a segment, then do it for each distance to vertex itself
-        for( size_t seg_idx=0; seg_idx<(vertices.size()-1); seg_idx++ )
-        {
-            // Compute the distance to this line segment
-            auto dist = Point_Line_Distance( point_list[point_id], 
-                                             vertices[seg_idx], 
-                                             vertices[seg_idx+1] );
-            if( segment_point_mapping[point_id].second < 0 || 
-                dist < segment_point_mapping[point_id].second )
-            {
-                segment_point_mapping[point_id].first = seg_idx;
-                segment_point_mapping[point_id].second = dist;
-            }
-        }
-    }
-
-    // For each segment, compute the density score
-    double segment_length;
-    double score = 0;
-    double total_length = 0;
-    for( size_t seg_idx=0; seg_idx < (vertices.size()-1); seg_idx++ )
-    {
-        double total_point_distance = 0;
-        int    num_points_in_segment = 0;
-
-        // For each mapped point, process the distance
-        for( const auto& seg_pnt : segment_point_mapping )
-        {
-            if( seg_pnt.second.first == seg_idx )
-            {
-                total_point_distance += seg_pnt.second.second;
-                num_points_in_segment += 1;
-            }
-        }
-        
-
-        // @todo:  Consider taking average of point distance?  
-        //     Pros:
-        //     Cons:
-        //     - Sum helps penalize overly long segments
-        //total_point_distance = std::pow(total_point_distance / (num_points_in_segment+1), 2);
-        
-        // Get the Segment Length
-        segment_length = Point::Distance_L2( vertices[seg_idx],
-                                             vertices[seg_idx+1] );
-        total_length += segment_length;
-
-        auto fit_part = total_point_distance;
-        score += fit_part;
-#ifdef PRINT_JUNK
-        std::cout << std::fixed << "fit: " << fit_part << ", Avg Pt Dist: " << total_point_distance << ", Seg: " << seg_idx << ", Length: " << segment_length << ", Num Points: " << num_points_in_segment << " of " << point_list.size() << std::endl;
-#endif
-    }
-
-    return score * total_length;
-}
\ No newline at end of file
+    auto& engine = Fitness_Engine::Thread_Instance();
+    engine.Assign( point_list, vertices );
+    return engine.Score_03();
+}
@@ -0,0 +1,114 @@
+/**
+ * @file    Job_Scheduler.cpp
+ * @author  Marvin Smith
+ * @date    1/12/2021
+ */
+#include "Job_Scheduler.hpp"
+
+// Boost Libraries
+#include <boost/log/trivial.hpp>
+
+// C++ Libraries
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+/********************************/
+/*          Constructor         */
+/********************************/
+Job_Scheduler::Job_Scheduler( unsigned int cpu_budget )
+  : m_pool( cpu_budget > 0 ? cpu_budget : std::max( 1U, std::thread::hardware_concurrency() ) )
+{
+    BOOST_LOG_TRIVIAL(debug) << "Job Scheduler using " << m_pool.size() << " worker threads";
+}
+
+/****************************************/
+/*          Queue a New Job             */
+/****************************************/
+void Job_Scheduler::Submit( const std::string& name,
+                            job_tp             job,
+                            double             priority )
+{
+    std::lock_guard<std::mutex> lck( m_mtx );
+
+    // Once a job has failed, nothing new starts until Wait_All reports it
+    if( m_error )
+    {
+        BOOST_LOG_TRIVIAL(warning) << "Job: " << name << ", Dropped after an earlier job failed";
+        return;
+    }
+    m_outstanding++;
+    m_pending.push( Pending_Job{ priority, m_sequence++, name, std::move( job ) } );
+    Dispatch();
+}
+
+/************************************************/
+/*          Hand Jobs to Free Workers           */
+/************************************************/
+void Job_Scheduler::Dispatch()
+{
+    while( m_running < m_pool.size() && !m_pending.empty() )
+    {
+        auto pending = m_pending.top();
+        m_pending.pop();
+        m_running++;
+        m_pool.enqueue_work( [this, pending](){ Run_Job( pending ); } );
+    }
+}
+
+/****************************************/
+/*          Run a Single Job            */
+/****************************************/
+void Job_Scheduler::Run_Job( const Pending_Job& pending )
+{
+    BOOST_LOG_TRIVIAL(debug) << "Job: " << pending.name << ", Starting.  Priority: " << pending.priority;
+    auto start_time = std::chrono::steady_clock::now();
+    std::exception_ptr error;
+    try
+    {
+        pending.job();
+    }
+    catch( std::exception& e )
+    {
+        BOOST_LOG_TRIVIAL(error) << "Job: " << pending.name << ", Caught Exception: " << e.what();
+        error = std::current_exception();
+    }
+    catch( ... )
+    {
+        BOOST_LOG_TRIVIAL(error) << "Job: " << pending.name << ", Caught Unknown Exception";
+        error = std::current_exception();
+    }
+    auto run_time = std::chrono::duration_cast<std::chrono::milliseconds>( std::chrono::steady_clock::now() - start_time ).count() / 1000.0;
+    BOOST_LOG_TRIVIAL(debug) << "Job: " << pending.name << ", Finished in " << run_time << " sec";
+
+    std::lock_guard<std::mutex> lck( m_mtx );
+    if( error && !m_error )
+    {
+        // Stop here like a single failing run would, and drop the jobs still waiting
+        m_error = error;
+        BOOST_LOG_TRIVIAL(error) << "Job: " << pending.name << ", Dropping " << m_pending.size() << " pending jobs";
+        m_outstanding -= m_pending.size();
+        m_pending = std::priority_queue<Pending_Job>();
+    }
+    m_running--;
+    Dispatch();
+    if( --m_outstanding == 0 )
+    {
+        m_done.notify_all();
+    }
+}
+
+/********************************************/
+/*          Wait for All Jobs               */
+/********************************************/
+void Job_Scheduler::Wait_All()
+{
+    std::unique_lock<std::mutex> lck( m_mtx );
+    m_done.wait( lck, [this](){ return m_outstanding == 0; } );
+    if( m_error )
+    {
+        auto error = m_error;
+        m_error = nullptr;
+        std::rethrow_exception( error );
+    }
+}
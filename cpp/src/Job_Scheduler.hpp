@@ -0,0 +1,129 @@
+/**
+ * @file    Job_Scheduler.hpp
+ * @author  Marvin Smith
+ * @date    1/12/2021
+ */
+#pragma once
+
+// C++ Libraries
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <vector>
+
+// Project Libraries
+#include "Thread_Pool.hpp"
+
+/**
+ * @class Job_Scheduler
+ * @brief Runs every GA job in the process on one bounded set of workers.
+ *
+ * A job is a (sector, waypoint-count) GA run, or the setup work in front of
+ * one.  Jobs run on the scheduler's Thread_Pool, and the fitness passes inside
+ * each job use parallel_for on that same pool.  A worker that has no job of its
+ * own picks up fitness chunks from whichever GAs are running, so the core count
+ * stays busy without ever going past the CPU budget.
+ *
+ * At most one job per worker is handed to the pool at a time.  The rest wait in
+ * a priority queue, so the most expensive jobs start first (longest processing
+ * time first) and the tail of a run is made of short jobs.
+ */
+class Job_Scheduler
+{
+    public:
+
+        /// Job Type
+        typedef std::function<void()> job_tp;
+
+        /**
+         * @brief Constructor
+         * @param cpu_budget Total number of worker threads (0 uses every core)
+         */
+        explicit Job_Scheduler( unsigned int cpu_budget = 0 );
+
+        /**
+         * @brief Queue a job
+         * @param name Job name used for logging
+         * @param job Work to run.  May submit more jobs.
+         * @param priority Higher runs first, e.g. the predicted cost.  Ties run in submit order.
+         */
+        void Submit( const std::string& name,
+                     job_tp             job,
+                     double             priority = 0 );
+
+        /**
+         * @brief Block until every submitted job, including ones submitted by other jobs, is done
+         * @note Rethrows the first exception thrown by a job.  Once a job fails, the pending
+         *       jobs are dropped and new submissions are ignored until Wait_All returns,
+         *       while the jobs already running finish.
+         */
+        void Wait_All();
+
+        /**
+         * @brief Get the worker pool, for nesting parallel_for inside a job
+         */
+        Thread_Pool& Get_Thread_Pool()
+        {
+            return m_pool;
+        }
+
+        /**
+         * @brief Get the number of worker threads
+         */
+        unsigned int Get_Number_Threads() const
+        {
+            return m_pool.size();
+        }
+
+    private:
+
+        /// Job waiting for a free worker
+        struct Pending_Job
+        {
+            double      priority;
+            size_t      sequence;
+            std::string name;
+            job_tp      job;
+
+            bool operator < ( const Pending_Job& rhs ) const
+            {
+                return ( priority < rhs.priority ) ||
+                       ( priority == rhs.priority && sequence > rhs.sequence );
+            }
+        };
+
+        /**
+         * @brief Hand pending jobs to the pool while workers are free
+         * @note Call with m_mtx held.
+         */
+        void Dispatch();
+
+        /**
+         * @brief Run one job and dispatch the next
+         */
+        void Run_Job( const Pending_Job& pending );
+
+        /// Shared Workers
+        Thread_Pool m_pool;
+
+        /// Jobs not yet handed to the pool
+        std::priority_queue<Pending_Job> m_pending;
+        size_t m_sequence { 0 };
+
+        /// Number of jobs handed to the pool and not yet finished
+        size_t m_running { 0 };
+
+        /// Number of submitted jobs not yet finished
+        size_t m_outstanding { 0 };
+
+        /// First job failure
+        std::exception_ptr m_error;
+
+        /// Completion Signal
+        std::mutex m_mtx;
+        std::condition_variable m_done;
+
+}; // End of Job_Scheduler Class
@@ -119,6 +119,43 @@ Options Parse_Command_Line( int argc, char* argv[] )
             output.ga_threads = std::stoi( args.front() );
             args.pop_front();
         }
+        else if( arg == "-cpu" )
+        {
+            output.cpu_budget = std::stoi( args.front() );
+            args.pop_front();
+        }
+        else if( arg == "-tournament" )
+        {
+            output.tournament_size = std::stoul( args.front() );
+            args.pop_front();
+        }
+        else if( arg == "-seed" )
+        {
+            output.random_seed = std::stoull( args.front() );
+            args.pop_front();
+        }
+        else if( arg == "-fcache" )
+        {
+            output.fitness_cache_size = std::stoul( args.front() );
+            args.pop_front();
+        }
+        else if( arg == "-parallel_sweep" )
+        {
+            output.parallel_sweep = true;
+        }
+        else if( arg == "-warm_start" )
+        {
+            output.warm_start = true;
+        }
+        else if( arg == "-snap_endpoints" )
+        {
+            output.snap_endpoints = true;
+        }
+        else if( arg == "-plateau" )
+        {
+            output.sweep_plateau_threshold = std::stod( args.front() );
+            args.pop_front();
+        }
         else if( arg == "-input" )
         {
             output.load_population_data = true;
@@ -149,6 +186,13 @@ Options Parse_Command_Line( int argc, char* argv[] )
         Usage( output );
     }
 
+    // Warm starts need the previous waypoint count to finish first
+    if( output.warm_start && output.parallel_sweep )
+    {
+        BOOST_LOG_TRIVIAL(warning) << "-warm_start needs a chained sweep, ignoring -parallel_sweep";
+        output.parallel_sweep = false;
+    }
+
     // Max Vertices
 
     // Create Exit Condition
@@ -159,6 +203,9 @@ Options Parse_Command_Line( int argc, char* argv[] )
     output.ga_config.selection_rate    = output.selection_rate;
     output.ga_config.random_vert_rate  = output.random_vert_rate;
     output.ga_config.number_threads    = output.ga_threads;
+    output.ga_config.fitness_cache_size = output.fitness_cache_size;
+    output.ga_config.tournament_size    = output.tournament_size;
+    output.ga_config.random_seed        = output.random_seed;
 
     return output;
 }
@@ -204,7 +251,29 @@ void Usage( const Options& options )
     sin << "   -stats <path>: Path to statistics file" << std::endl;
     sin << "       - Default: " << options.ga_config.stats_output_pathname << std::endl;
     sin << "   -gt <int>    : Number of threads to use in the population fitness update." << std::endl;
+    sin << "       - Note: Superseded by -cpu.  All GA jobs now share one worker pool." << std::endl;
     sin << "       - Default: " << options.ga_threads << std::endl;
+    sin << "   -cpu <int>   : Total number of worker threads shared by every sector and waypoint count." << std::endl;
+    sin << "       - Note: 0 means use every core." << std::endl;
+    sin << "       - Default: " << options.cpu_budget << std::endl;
+    sin << "   -tournament <int> : Pick each parent as the fittest of this many random members." << std::endl;
+    sin << "       - Note: 0 picks parents from the top selection-rate share instead." << std::endl;
+    sin << "       - Default: " << options.tournament_size << std::endl;
+    sin << "   -seed <int> : Seed for all random draws.  Runs with the same seed and inputs give" << std::endl;
+    sin << "                 the same results, whatever the -cpu setting." << std::endl;
+    sin << "       - Default: Current time (Logged at startup)" << std::endl;
+    sin << "   -fcache <int> : Number of fitness scores each GA run remembers, keyed by genome." << std::endl;
+    sin << "       - Note: 0 disables the cache." << std::endl;
+    sin << "       - Default: " << options.fitness_cache_size << std::endl;
+    sin << "   -parallel_sweep : Run a sector's waypoint counts concurrently." << std::endl;
+    sin << "       - Note: Populations are still written in waypoint order." << std::endl;
+    sin << "   -warm_start : Start each waypoint count from the previous count's elite population," << std::endl;
+    sin << "                 lifted by one waypoint.  Ignores -parallel_sweep." << std::endl;
+    sin << "   -snap_endpoints : Move each sector's start and end points onto the nearest point of the track." << std::endl;
+    sin << "   -plateau <float> : Stop a sector's waypoint sweep once one more waypoint improves" << std::endl;
+    sin << "                      the best fitness by less than this fraction [0-1]" << std::endl;
+    sin << "       - Note: 0 disables the check." << std::endl;
+    sin << "       - Default: " << options.sweep_plateau_threshold << std::endl;
     sin << "   -input <path> : Load the initial population data from disk." << std::endl;
     sin << "       - Default behavior is to randomly generate a population." << std::endl;
     sin << "         Too few entries will result in the remaining entries being randomly created." << std::endl;
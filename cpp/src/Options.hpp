@@ -6,6 +6,8 @@
 #pragma once
 
 // C++ Libraries
+#include <cstdint>
+#include <ctime>
 #include <filesystem>
 #include <map>
 #include <string>
@@ -58,9 +60,33 @@ struct Options
     double mutation_rate { 0.8 };
     double random_vert_rate { 0.05 };
 
-    // Genetic Algorithm Thread
+    // Genetic Algorithm Thread (Superseded by cpu_budget)
     int ga_threads = 2;
 
+    // Total number of worker threads for all GA jobs (0 uses every core)
+    unsigned int cpu_budget { 0 };
+
+    // Run a sector's waypoint counts concurrently instead of one after another
+    bool parallel_sweep { false };
+
+    // Stop the waypoint sweep once an extra waypoint improves the best fitness by less than this fraction (0 disables)
+    double sweep_plateau_threshold { 0 };
+
+    // Start each waypoint count from the previous count's elite, lifted by one waypoint (Forces a chained sweep)
+    bool warm_start { false };
+
+    // Move each sector's start and end points onto the nearest reference point
+    bool snap_endpoints { false };
+
+    // Parents are the fittest of this many random members (0 uses the top selection_rate share instead)
+    size_t tournament_size { 0 };
+
+    // Fitness cache entries per GA run (0 disables the cache)
+    size_t fitness_cache_size { 1 << 16 };
+
+    // Seed for every random draw in the run (Same seed, same results, whatever the thread count)
+    uint64_t random_seed { (uint64_t)time(nullptr) };
+
     // Flag if we want to load the population data rather than randomly generate
     bool load_population_data { false };
 
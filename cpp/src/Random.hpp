@@ -0,0 +1,104 @@
+/**
+ * @file    Random.hpp
+ * @author  Marvin Smith
+ * @date    1/16/2021
+ */
+#pragma once
+
+// C++ Libraries
+#include <cstdint>
+#include <string>
+
+/**
+ * @class Random_Generator
+ * @brief Small, cheap, counter-based random number generator (SplitMix64).
+ *
+ * Each output is a mix of the seed plus a step counter, so building one
+ * generator per task from (seed, stream) gives independent sequences without
+ * any shared state between threads.  Seeds are derived down a key path
+ * (run seed, sector, waypoint count, generation) with Derive_Seed, and the
+ * last key is the stream, so every draw depends only on where it was made,
+ * never on which thread made it.
+ */
+class Random_Generator
+{
+    public:
+
+        /**
+         * @brief Constructor
+         * @param seed Seed shared by a group of generators (e.g. one generation)
+         * @param stream Index of this generator within the group
+         */
+        explicit Random_Generator( uint64_t seed,
+                                   uint64_t stream = 0 )
+          : m_state( Derive_Seed( seed, stream ) )
+        {
+        }
+
+        /**
+         * @brief Derive the seed for one part of a run
+         */
+        static uint64_t Derive_Seed( uint64_t seed,
+                                     uint64_t key )
+        {
+            return Mix( seed ^ Mix( key + GOLDEN_GAMMA ) );
+        }
+
+        /**
+         * @brief Derive the seed for one part of a run, keyed by name (e.g. sector id)
+         */
+        static uint64_t Derive_Seed( uint64_t           seed,
+                                     const std::string& key )
+        {
+            // FNV-1a, so the key does not depend on the standard library's string hash
+            uint64_t hash = 0xCBF29CE484222325ULL;
+            for( unsigned char c : key )
+            {
+                hash = ( hash ^ c ) * 0x100000001B3ULL;
+            }
+            return Derive_Seed( seed, hash );
+        }
+
+        /**
+         * @brief Get the next 64 random bits
+         */
+        uint64_t Next()
+        {
+            m_state += GOLDEN_GAMMA;
+            return Mix( m_state );
+        }
+
+        /**
+         * @brief Get a random integer in [0,range)
+         */
+        uint64_t Uniform( uint64_t range )
+        {
+            // Multiply-high instead of modulo (No division, negligible bias for small ranges)
+            return ( (unsigned __int128)Next() * range ) >> 64;
+        }
+
+        /**
+         * @brief Get a random value in [0,1)
+         */
+        double Uniform_Real()
+        {
+            return ( Next() >> 11 ) * ( 1.0 / ( uint64_t(1) << 53 ) );
+        }
+
+    private:
+
+        /**
+         * @brief SplitMix64 Finalizer
+         */
+        static uint64_t Mix( uint64_t z )
+        {
+            z = ( z ^ ( z >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+            z = ( z ^ ( z >> 27 ) ) * 0x94D049BB133111EBULL;
+            return z ^ ( z >> 31 );
+        }
+
+        static constexpr uint64_t GOLDEN_GAMMA = 0x9E3779B97F4A7C15ULL;
+
+        uint64_t m_state;
+
+}; // End of Random_Generator Class
@@ -9,10 +9,11 @@
 #include <boost/log/trivial.hpp>
 
 // C++ Libraries
+#include <chrono>
 #include <functional>
+#include <stdexcept>
 
 // Project Libraries
-#include "Context.hpp"
 #include "Genetic_Algorithm.hpp"
 #include "WaypointList.hpp"
 #include "Write_Worker.hpp"
@@ -25,6 +26,8 @@ using namespace std::placeholders;
 Sector_Runner::Sector_Runner( sqlite3*                             db,
                               const std::string&                   sector_id,
                               const std::tuple<DB_Point,DB_Point>& sector_endpoints,
+                              size_t                               number_points,
+                              const Cost_Model&                    cost_model,
                               const Options&                       options,
                               OGRCoordinateTransformation*         xform_utm2dd,
                               OGRCoordinateTransformation*         xform_dd2utm,
@@ -36,6 +39,8 @@ Sector_Runner::Sector_Runner( sqlite3*                             db,
   : m_db( db ),
     m_sector_id( sector_id ),
     m_sector_endpoints( sector_endpoints ),
+    m_number_points( number_points ),
+    m_cost_model( cost_model ),
     m_options( options ),
     m_xform_utm2dd( xform_utm2dd ),
     m_xform_dd2utm( xform_dd2utm ),
@@ -48,154 +53,319 @@ Sector_Runner::Sector_Runner( sqlite3*                             db,
     BOOST_LOG_TRIVIAL(debug) << "Constructed Runner for Sector: " << m_sector_id;
 }
 
-/****************************/
-/*          Runner          */
-/****************************/
-void Sector_Runner::Run()
+/****************************************/
+/*          Queue the Sector Jobs       */
+/****************************************/
+void Sector_Runner::Start( Job_Scheduler& scheduler )
+{
+    double predicted_sec = Predict_Sweep_Seconds( m_options.min_waypoints,
+                                                  m_options.max_waypoints );
+    BOOST_LOG_TRIVIAL(info) << "Sector: " << m_sector_id << ", Points: " << m_number_points
+                            << ", Predicted Run Time: " << predicted_sec << " sec";
+    scheduler.Submit( m_sector_id + ", Prepare",
+                      [this, &scheduler](){ Prepare( scheduler ); },
+                      predicted_sec );
+}
+
+/****************************************************/
+/*          Predict the Cost of a Sweep             */
+/****************************************************/
+double Sector_Runner::Predict_Sweep_Seconds( int first_waypoints,
+                                             int last_waypoints ) const
+{
+    double predicted_sec = 0;
+    for( int num_waypoints = first_waypoints; num_waypoints <= last_waypoints; num_waypoints++ )
+    {
+        predicted_sec += m_cost_model.Predict_Seconds( Cost_Model::Work_Units( m_number_points,
+                                                                               num_waypoints,
+                                                                               m_options.population_size,
+                                                                               m_options.max_iterations ) );
+    }
+    return predicted_sec;
+}
+
+/****************************************/
+/*          Load the Sector Data        */
+/****************************************/
+void Sector_Runner::Prepare( Job_Scheduler& scheduler )
 {
     BOOST_LOG_TRIVIAL(debug) << "Start of Runner for Sector: " << m_sector_id;
-    std::lock_guard<std::mutex> lck(m_run_mtx);
 
-    try
+    // For the sector, load the points
+    auto point_list = Load_Point_List( m_db, m_sector_id );
+    m_number_points = point_list.size();
+
+    // Get point range
+    auto point_range = Normalize_Points( point_list );
+    size_t x_digits = log10(std::get<2>(point_range) - std::get<0>(point_range)) + 1;
+    size_t y_digits = log10(std::get<3>(point_range) - std::get<1>(point_range)) + 1;
+    m_max_x = std::get<2>(point_range) - std::get<0>(point_range) + 1;
+    m_max_y = std::get<3>(point_range) - std::get<1>(point_range) + 1;
+    if( m_max_x > WaypointList::MAX_RANGE || m_max_y > WaypointList::MAX_RANGE )
+    {
+        std::string message = "Sector: " + m_sector_id + ", Extent " + std::to_string( m_max_x ) + " x " +
+                              std::to_string( m_max_y ) + " m does not fit the genome (Max " +
+                              std::to_string( WaypointList::MAX_RANGE ) + " m per axis)";
+        BOOST_LOG_TRIVIAL(error) << message;
+        throw std::runtime_error( message );
+    }
+    BOOST_LOG_TRIVIAL(debug) << "Sector: " << m_sector_id << ", X Digits: " << x_digits << ", Y Digits: " << y_digits;
+    BOOST_LOG_TRIVIAL(debug) << "Sector: " << m_sector_id << ", Min: [" << std::get<0>(point_range) << ", " << std::get<1>(point_range) 
+                             << "], Max: [" << std::get<2>(point_range) << ", " << std::get<3>(point_range) << "]"; 
+
+    // Convert Start and End point to the normalized UTM
+    auto start_point = Convert_Coordinate( m_xform_dd2utm, 
+                                           std::get<0>( m_sector_endpoints ).Get_LLA_Coordinate() ) - ToPoint2D( std::get<0>(point_range),
+                                                                                                                 std::get<1>(point_range) );
+    auto end_point = Convert_Coordinate( m_xform_dd2utm, 
+                                         std::get<1>( m_sector_endpoints ).Get_LLA_Coordinate() ) - ToPoint2D( std::get<0>(point_range), 
+                                                                                                               std::get<1>(point_range) );
+    BOOST_LOG_TRIVIAL(debug) << "Sector: " << m_sector_id << ", Starting Point: " << start_point.To_String() << ", Ending Point: " << end_point.To_String();
+
+    // Construct the Context info (shared read-only by every GA worker)
+    m_context = Context::Create( point_list,
+                                 start_point,
+                                 end_point,
+                                 m_options.snap_endpoints );
+    if( m_options.snap_endpoints )
+    {
+        BOOST_LOG_TRIVIAL(debug) << "Sector: " << m_sector_id << ", Snapped Starting Point: " << m_context->start_point.To_String()
+                                 << " (Moved " << Point::Distance_L2( start_point, m_context->start_point ) << ")"
+                                 << ", Snapped Ending Point: " << m_context->end_point.To_String()
+                                 << " (Moved " << Point::Distance_L2( end_point, m_context->end_point ) << ")";
+    }
+
+    // Input population data (if requested)
+    if( m_options.load_population_data )
+    {
+        m_loaded_population = Load_Population( m_options.population_path,
+                                               m_options.min_waypoints,
+                                               m_options.max_waypoints,
+                                               m_options.population_size );
+    }
+    else if( m_options.seed_dataset_id >= 0 )
     {
-        // For the sector, load the points
-        auto point_list = Load_Point_List( m_db, m_sector_id );
-
-        // Get point range
-        auto point_range = Normalize_Points( point_list );
-        size_t x_digits = log10(std::get<2>(point_range) - std::get<0>(point_range)) + 1;
-        size_t y_digits = log10(std::get<3>(point_range) - std::get<1>(point_range)) + 1;
-        size_t max_x = std::get<2>(point_range) - std::get<0>(point_range) + 1;
-        size_t max_y = std::get<3>(point_range) - std::get<1>(point_range) + 1;
-        BOOST_LOG_TRIVIAL(debug) << "Sector: " << m_sector_id << ", X Digits: " << x_digits << ", Y Digits: " << y_digits;
-        BOOST_LOG_TRIVIAL(debug) << "Sector: " << m_sector_id << ", Min: [" << std::get<0>(point_range) << ", " << std::get<1>(point_range) 
-                                 << "], Max: [" << std::get<2>(point_range) << ", " << std::get<3>(point_range) << "]"; 
-
-        // Convert Start and End point to the normalized UTM
-        auto start_point = Convert_Coordinate( m_xform_dd2utm, 
-                                               std::get<0>( m_sector_endpoints ).Get_LLA_Coordinate() ) - ToPoint2D( std::get<0>(point_range),
-                                                                                                                     std::get<1>(point_range) );
-        auto end_point = Convert_Coordinate( m_xform_dd2utm, 
-                                             std::get<1>( m_sector_endpoints ).Get_LLA_Coordinate() ) - ToPoint2D( std::get<0>(point_range), 
-                                                                                                                   std::get<1>(point_range) );
-        BOOST_LOG_TRIVIAL(debug) << "Sector: " << m_sector_id << ", Starting Point: " << start_point.To_String() << ", Ending Point: " << end_point.To_String();
-
-        // Construct the Context info
-        Context context;
-        context.point_list = point_list;
-        context.start_point = start_point;
-        context.end_point   = end_point;
-        for( const auto& pt : context.point_list )
+        auto dataset_points = Load_Point_List( m_db, 
+                                               m_sector_id,
+                                               m_options.seed_dataset_id );
+
+        // Normalize
+        Normalize_Points( dataset_points, 
+                          std::get<0>(point_range),
+                          std::get<1>(point_range) );
+        std::vector<Point> dpoints;
+        for( const auto& pt : dataset_points )
         {
-            context.geo_point_list.push_back( ToPoint2D( pt.x_norm, pt.y_norm ) );
+            dpoints.push_back( ToPoint2D( pt.x_norm, pt.y_norm ) );
         }
-        auto context_ptr = reinterpret_cast<void*>( &context );
 
-        // Input population data (if requested)
-        std::map<int,std::vector<WaypointList>> loaded_population;
-        if( m_options.load_population_data )
+        BOOST_LOG_TRIVIAL(debug) << "Sector: " << m_sector_id << ", Building Population from Dataset " << m_options.seed_dataset_id;
+        Random_Generator rng( Random_Generator::Derive_Seed( m_options.random_seed, m_sector_id + "/seed_population" ) );
+        m_loaded_population = Seed_Population( dpoints,
+                                               m_options.min_waypoints,
+                                               m_options.max_waypoints,
+                                               m_options.population_size,
+                                               m_max_x, m_max_y, 
+                                               m_context->start_point,
+                                               m_context->end_point,
+                                               rng );
+    }
+
+    // Create the file writing information
+    auto writer_obj = std::make_shared<Write_Worker>( m_xform_utm2dd,
+                                                      point_range,
+                                                      point_list.front().gz,
+                                                      m_master_vertex_list );
+    m_write_worker = std::bind( &Write_Worker::Write, writer_obj, _1, _2, _3 );
+
+    // Start the waypoint sweep
+    m_next_write = m_options.min_waypoints;
+    m_last_waypoints = m_options.max_waypoints;
+    if( m_options.parallel_sweep )
+    {
+        for( int num_waypoints = m_options.min_waypoints; num_waypoints <= m_options.max_waypoints; num_waypoints++ )
         {
-            loaded_population = Load_Population( m_options.population_path,
-                                                 m_options.min_waypoints,
-                                                 m_options.max_waypoints,
-                                                 m_options.population_size );
+            Submit_Waypoint_Count( scheduler, num_waypoints );
         }
-        else if( m_options.seed_dataset_id >= 0 )
-        {
-            auto dataset_points = Load_Point_List( m_db, 
-                                                   m_sector_id,
-                                                   m_options.seed_dataset_id );
-
-            // Normalize
-            Normalize_Points( dataset_points, 
-                              std::get<0>(point_range),
-                              std::get<1>(point_range) );
-            std::vector<Point> dpoints;
-            for( const auto& pt : dataset_points )
-            {
-                dpoints.push_back( ToPoint2D( pt.x_norm, pt.y_norm ) );
-            }
+    }
+    else if( m_options.min_waypoints <= m_options.max_waypoints )
+    {
+        Submit_Waypoint_Count( scheduler, m_options.min_waypoints );
+    }
+}
 
-            BOOST_LOG_TRIVIAL(debug) << "Sector: " << m_sector_id << ", Building Population from Dataset " << m_options.seed_dataset_id;
-            loaded_population = Seed_Population( dpoints,
-                                                 m_options.min_waypoints,
-                                                 m_options.max_waypoints,
-                                                 m_options.population_size,
-                                                 max_x, max_y, 
-                                                 start_point,
-                                                 end_point );
-        }
+/************************************************/
+/*          Queue a Single Waypoint Count       */
+/************************************************/
+void Sector_Runner::Submit_Waypoint_Count( Job_Scheduler& scheduler,
+                                           int            num_waypoints )
+{
+    // A chained job carries the cost of the rest of the chain
+    int last_waypoints = m_options.parallel_sweep ? num_waypoints : m_options.max_waypoints;
+    scheduler.Submit( m_sector_id + ", Waypoints: " + std::to_string( num_waypoints ),
+                      [this, &scheduler, num_waypoints](){ Run_Waypoint_Count( scheduler, num_waypoints ); },
+                      Predict_Sweep_Seconds( num_waypoints, last_waypoints ) );
+}
 
-        // Create the file writing information
-        auto writer_obj = std::make_shared<Write_Worker>( m_xform_utm2dd,
-                                                          point_range,
-                                                          point_list.front().gz,
-                                                          m_master_vertex_list );
-        Write_Worker::writer_func_tp write_worker = std::bind( &Write_Worker::Write, writer_obj, _1, _2, _3 );
-
-        // Iterate over each waypoint count
-        for( int num_waypoints = m_options.min_waypoints; 
-             num_waypoints <= m_options.max_waypoints;
-             num_waypoints++ )
-        {
-            // Build the initial population
-            std::vector<WaypointList> initial_population;
-            if( loaded_population.empty() )
-            {
-                initial_population = Build_Random_Waypoints( m_options.population_size,
-                                                             num_waypoints,
-                                                             max_x, max_y,
-                                                             start_point,
-                                                             end_point );
-            }
-            else
-            {
-                initial_population = loaded_population[num_waypoints];
-            }
-        
-            // Load the population list
-            BOOST_LOG_TRIVIAL(debug) << "Sector: " << m_sector_id << ", Initial Population List, " << Print_Population_List( initial_population, 10 );
-
-            // Construct Genetic Algorithm
-            Genetic_Algorithm<WaypointList> ga( m_options.ga_config,
-                                                initial_population,
-                                                m_crossover_algorithm,
-                                                m_mutation_algorithm,
-                                                m_random_algorithm,
-                                                write_worker,
-                                                m_stats_aggregator );
-
-            // Run the GA
-            auto exit_condition = std::make_shared<Exit_Condition>( m_options.exit_condition->Get_Max_Matches(),
-                                                                    m_options.exit_condition->Get_EPS() );
-            auto population = ga.Run( m_sector_id,
-                                      m_options.max_iterations,
-                                      exit_condition,
-                                      context_ptr );
-
-            // Check our results
-            BOOST_LOG_TRIVIAL(debug) << "Sector: " << m_sector_id << ", Most Fit Population List, " << Print_Population_List( population, 10 );
-            BOOST_LOG_TRIVIAL(debug) << "Sector: " << m_sector_id << ", Best Fit Item: " << population[0].To_String(true);
-
-            // Write the population data to disk
-            Write_Population( population, 
-                              m_sector_id,
-                              m_options.population_path, 
-                              true );
-    
-        } // End of Waypoint Number Loop
-    } 
-    catch( std::exception& e )
+/************************************************/
+/*          Run a Single Waypoint Count         */
+/************************************************/
+void Sector_Runner::Run_Waypoint_Count( Job_Scheduler& scheduler,
+                                        int            num_waypoints )
+{
+    // Skip counts past a fitness plateau
+    if( num_waypoints > m_last_waypoints )
+    {
+        BOOST_LOG_TRIVIAL(debug) << "Sector: " << m_sector_id << ", Skipping Waypoints: " << num_waypoints;
+        Commit_Population( num_waypoints, {} );
+        return;
+    }
+
+    // Every random draw for this count is keyed by (seed, sector, waypoints), whatever thread runs it
+    const uint64_t run_seed = Random_Generator::Derive_Seed( Random_Generator::Derive_Seed( m_options.random_seed, m_sector_id ),
+                                                             num_waypoints );
+    Random_Generator rng( Random_Generator::Derive_Seed( run_seed, "initial_population" ) );
+
+    // Build the initial population
+    std::vector<WaypointList> initial_population;
+    if( !m_warm_population.empty() )
+    {
+        // Fill in behind the lifted elite with random members
+        initial_population = std::move( m_warm_population );
+        m_warm_population.clear();
+        auto random_population = Build_Random_Waypoints( m_options.population_size - std::min( m_options.population_size, initial_population.size() ),
+                                                         num_waypoints,
+                                                         m_max_x, m_max_y,
+                                                         m_context->start_point,
+                                                         m_context->end_point,
+                                                         rng );
+        initial_population.insert( initial_population.end(),
+                                   random_population.begin(),
+                                   random_population.end() );
+    }
+    else if( m_loaded_population.empty() )
+    {
+        initial_population = Build_Random_Waypoints( m_options.population_size,
+                                                     num_waypoints,
+                                                     m_max_x, m_max_y,
+                                                     m_context->start_point,
+                                                     m_context->end_point,
+                                                     rng );
+    }
+    else
+    {
+        initial_population = m_loaded_population.at( num_waypoints );
+    }
+
+    // Load the population list
+    BOOST_LOG_TRIVIAL(debug) << "Sector: " << m_sector_id << ", Initial Population List, " << Print_Population_List( initial_population, 10 );
+
+    // Construct Genetic Algorithm
+    auto ga_config = m_options.ga_config;
+    ga_config.random_seed = run_seed;
+    Genetic_Algorithm<WaypointList> ga( ga_config,
+                                        std::move( initial_population ),
+                                        m_crossover_algorithm,
+                                        m_mutation_algorithm,
+                                        m_random_algorithm,
+                                        m_write_worker,
+                                        m_stats_aggregator,
+                                        scheduler.Get_Thread_Pool() );
+
+    // Run the GA
+    auto work_units = Cost_Model::Work_Units( m_number_points,
+                                              num_waypoints,
+                                              m_options.population_size,
+                                              m_options.max_iterations );
+    double predicted_sec = m_cost_model.Predict_Seconds( work_units );
+    auto start_run = std::chrono::steady_clock::now();
+
+    auto exit_condition = std::make_shared<Exit_Condition>( m_options.exit_condition->Get_Max_Matches(),
+                                                            m_options.exit_condition->Get_EPS() );
+    auto population = ga.Run( m_sector_id,
+                              m_context,
+                              m_options.max_iterations,
+                              exit_condition );
+
+    // Feed the actual time back into the cost model, sized by the generations actually run
+    auto actual_sec = std::chrono::duration_cast<std::chrono::milliseconds>( std::chrono::steady_clock::now() - start_run ).count() / 1000.0;
+    auto run_units = Cost_Model::Work_Units( m_number_points,
+                                             num_waypoints,
+                                             m_options.population_size,
+                                             ga.Get_Number_Iterations() );
+    m_stats_aggregator.Report_Job_Cost( m_sector_id,
+                                        num_waypoints,
+                                        ga.Get_Number_Iterations(),
+                                        run_units.point_units,
+                                        run_units.segment_units,
+                                        predicted_sec,
+                                        actual_sec );
+
+    // Check our results
+    BOOST_LOG_TRIVIAL(debug) << "Sector: " << m_sector_id << ", Most Fit Population List, " << Print_Population_List( population, 10 );
+    BOOST_LOG_TRIVIAL(debug) << "Sector: " << m_sector_id << ", Best Fit Item: " << population[0].To_String(true);
+
+    // Lift the elite before the population is handed off
+    std::vector<WaypointList> elite;
+    if( m_options.warm_start )
+    {
+        size_t elite_size = std::max<size_t>( 1, m_options.selection_rate * population.size() );
+        elite.assign( population.begin(),
+                      population.begin() + std::min( elite_size, population.size() ) );
+    }
+
+    // Write the population data to disk
+    Commit_Population( num_waypoints, std::move( population ) );
+
+    // Chain the next waypoint count
+    if( !m_options.parallel_sweep && num_waypoints < m_last_waypoints )
     {
-        BOOST_LOG_TRIVIAL(error) << "Sector: " << m_sector_id << ", Caught Exception: " << e.what();
-        std::exit(1);
+        if( m_options.warm_start )
+        {
+            m_warm_population = Lift_Population( elite, *m_context );
+        }
+        Submit_Waypoint_Count( scheduler, num_waypoints + 1 );
     }
 }
 
 /****************************************************/
-/*          Block Until Completion Finished         */
+/*          Write Populations in Waypoint Order     */
 /****************************************************/
-void Sector_Runner::Wait_Completion()
+void Sector_Runner::Commit_Population( int                         num_waypoints,
+                                       std::vector<WaypointList>&& population )
 {
-    std::lock_guard<std::mutex> lck(m_run_mtx);
-}
\ No newline at end of file
+    std::lock_guard<std::mutex> lck( m_results_mtx );
+    m_finished_populations[num_waypoints] = std::move( population );
+
+    while( !m_finished_populations.empty() &&
+           m_finished_populations.begin()->first == m_next_write )
+    {
+        // Anything past the plateau is dropped, even if it already ran, so the output does not depend on timing
+        const auto& finished = m_finished_populations.begin()->second;
+        if( !finished.empty() && m_next_write <= m_last_waypoints )
+        {
+            Write_Population( finished,
+                              m_sector_id,
+                              m_options.population_path,
+                              true );
+
+            // Check if the extra waypoint was worth it
+            double best_fitness = finished.front().Get_Fitness();
+            if( m_options.sweep_plateau_threshold > 0 && m_last_best_fitness > 0 )
+            {
+                double improvement = ( m_last_best_fitness - best_fitness ) / m_last_best_fitness;
+                if( improvement < m_options.sweep_plateau_threshold )
+                {
+                    m_last_waypoints = m_next_write;
+                    m_stats_aggregator.Report_Sweep_Stop( m_sector_id,
+                                                          m_next_write,
+                                                          best_fitness,
+                                                          improvement );
+                }
+            }
+            m_last_best_fitness = best_fitness;
+        }
+        m_finished_populations.erase( m_finished_populations.begin() );
+        m_next_write++;
+    }
+}
@@ -6,18 +6,33 @@
 #pragma once
 
 // Project Libraries
+#include "Context.hpp"
+#include "Cost_Model.hpp"
 #include "DB_Utils.hpp"
 #include "GDAL_Utilities.hpp"
+#include "Job_Scheduler.hpp"
 #include "Options.hpp"
 #include "Stats_Aggregator.hpp"
 #include "Write_Worker.hpp"
 
 // C++ Libraries
+#include <atomic>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 /**
  * @class Sector_Runner
+ *
+ * Splits a sector into scheduler jobs.  The first job loads and normalizes the
+ * sector data, then each waypoint count runs as its own GA job.  By default the
+ * waypoint counts are chained and each job is prioritized by the predicted cost
+ * of what is left of the chain.  With parallel_sweep they are all queued at once
+ * and share the sector's Context.  Either way, populations are written in
+ * waypoint order.  If sweep_plateau_threshold is set, waypoint counts past the
+ * point where the best fitness stops improving are skipped.  With warm_start,
+ * each count starts from the previous count's elite (See Lift_Population).
  */
 class Sector_Runner
 {
@@ -32,6 +47,8 @@ class Sector_Runner
         Sector_Runner( sqlite3*                             db,
                        const std::string&                   sector_id,
                        const std::tuple<DB_Point,DB_Point>& sector_endpoints,
+                       size_t                               number_points,
+                       const Cost_Model&                    cost_model,
                        const Options&                       options,
                        OGRCoordinateTransformation*         xform_utm2dd,
                        OGRCoordinateTransformation*         xform_dd2utm,
@@ -42,14 +59,43 @@ class Sector_Runner
                        Stats_Aggregator&                    stats_aggregator );
 
         /**
-         * @brief Run the algorithm for the constructed Sector-ID
+         * @brief Queue the jobs for the constructed Sector-ID
+         * @note The runner must outlive the scheduler's Wait_All.
          */
-        void Run();
-
-        void Wait_Completion();
+        void Start( Job_Scheduler& scheduler );
 
     private:
 
+        /**
+         * @brief Load the sector data, then queue the first waypoint count
+         */
+        void Prepare( Job_Scheduler& scheduler );
+
+        /**
+         * @brief Predict the run time of the waypoint counts in [first_waypoints,last_waypoints]
+         */
+        double Predict_Sweep_Seconds( int first_waypoints,
+                                      int last_waypoints ) const;
+
+        /**
+         * @brief Queue the GA job for one waypoint count
+         */
+        void Submit_Waypoint_Count( Job_Scheduler& scheduler,
+                                    int            num_waypoints );
+
+        /**
+         * @brief Run the GA for one waypoint count, then queue the next one (unless parallel_sweep)
+         */
+        void Run_Waypoint_Count( Job_Scheduler& scheduler,
+                                 int            num_waypoints );
+
+        /**
+         * @brief Hold a finished population until every smaller waypoint count is written
+         * @note Skipped waypoint counts commit an empty population.
+         */
+        void Commit_Population( int                         num_waypoints,
+                                std::vector<WaypointList>&& population );
+
         /// Database Handle
         sqlite3* m_db;
 
@@ -59,6 +105,12 @@ class Sector_Runner
         /// Sector Data
         std::tuple<DB_Point,DB_Point> m_sector_endpoints;
 
+        /// Number of Sector Points (Exact once Prepare has run)
+        size_t m_number_points;
+
+        /// Job Cost Estimates
+        const Cost_Model& m_cost_model;
+
         /// Options Class
         Options m_options;
 
@@ -83,7 +135,25 @@ class Sector_Runner
         /// Stats Aggregator
         Stats_Aggregator&  m_stats_aggregator;
 
-        /// Run Mutex
-        std::mutex m_run_mtx;
+        /// Sector Data (Filled by Prepare)
+        Context::ptr_t m_context;
+        size_t m_max_x { 0 };
+        size_t m_max_y { 0 };
+        std::map<int,std::vector<WaypointList>> m_loaded_population;
+        Write_Worker::writer_func_tp m_write_worker;
+
+        /// Finished populations waiting on a smaller waypoint count
+        std::mutex m_results_mtx;
+        std::map<int,std::vector<WaypointList>> m_finished_populations;
+        int m_next_write { 0 };
+
+        /// Lifted elite of the last waypoint count (Chained sweep only)
+        std::vector<WaypointList> m_warm_population;
+
+        /// Best fitness of the last population written
+        double m_last_best_fitness { -1 };
+
+        /// Largest waypoint count still worth running (Lowered when the sweep plateaus)
+        std::atomic_int m_last_waypoints { 0 };
 
 }; // End of Sector_Runner Class
\ No newline at end of file
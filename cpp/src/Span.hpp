@@ -0,0 +1,131 @@
+/**
+ * @file    Span.hpp
+ * @author  Marvin Smith
+ * @date    1/9/2021
+ */
+#pragma once
+
+// C++ Libraries
+#include <cassert>
+#include <cstddef>
+
+/**
+ * @class Span
+ * @brief Non-owning view over a contiguous array.
+ *
+ * Stand-in for std::span until the project moves past C++17.
+ */
+template <typename TP>
+class Span
+{
+    public:
+
+        /// Element Type
+        typedef TP element_type;
+
+        /**
+         * @brief Default Constructor (Empty View)
+         */
+        Span() = default;
+
+        /**
+         * @brief Parameterized Constructor
+         * @param data Pointer to the first element
+         * @param size Number of elements
+         */
+        Span( TP* data, size_t size )
+          : m_data( data ),
+            m_size( size )
+        {
+        }
+
+        /**
+         * @brief Build a view over any contiguous container (std::vector, std::array)
+         */
+        template <typename Container>
+        Span( Container& container )
+          : m_data( container.data() ),
+            m_size( container.size() )
+        {
+        }
+
+        /**
+         * @brief Get the Number of Elements
+         */
+        size_t size() const
+        {
+            return m_size;
+        }
+
+        /**
+         * @brief Check if the View is Empty
+         */
+        bool empty() const
+        {
+            return m_size == 0;
+        }
+
+        /**
+         * @brief Get the Underlying Pointer
+         */
+        TP* data() const
+        {
+            return m_data;
+        }
+
+        /**
+         * @brief Element Access
+         */
+        TP& operator[]( size_t idx ) const
+        {
+            assert( idx < m_size );
+            return m_data[idx];
+        }
+
+        /**
+         * @brief Get the first element
+         */
+        TP& front() const
+        {
+            return m_data[0];
+        }
+
+        /**
+         * @brief Get the last element
+         */
+        TP& back() const
+        {
+            return m_data[m_size-1];
+        }
+
+        /**
+         * @brief Iterator Access
+         */
+        TP* begin() const
+        {
+            return m_data;
+        }
+
+        TP* end() const
+        {
+            return m_data + m_size;
+        }
+
+        /**
+         * @brief Create a view over a subset of the elements
+         */
+        Span<TP> subspan( size_t offset, size_t count ) const
+        {
+            assert( offset + count <= m_size );
+            return Span<TP>( m_data + offset, count );
+        }
+
+    private:
+
+        /// Data Pointer
+        TP* m_data { nullptr };
+
+        /// Number of Elements
+        size_t m_size { 0 };
+
+}; // End of Span Class
@@ -31,6 +31,17 @@ Stats_Aggregator::~Stats_Aggregator()
         BOOST_LOG_TRIVIAL(info) << subsystem.second.To_String( "Subsystem: " + subsystem.first, "sec" );
     }
 
+    {
+        std::lock_guard<std::mutex> lck(m_cache_mtx);
+        size_t lookups = m_cache_hits + m_cache_misses;
+        if( lookups > 0 )
+        {
+            BOOST_LOG_TRIVIAL(info) << "Fitness Cache. Hits: " << m_cache_hits << ", Misses: " << m_cache_misses
+                                    << " (Bloom Filtered: " << m_cache_filtered << "), Hit Rate: "
+                                    << std::fixed << 100.0 * m_cache_hits / lookups << "%";
+        }
+    }
+
     Stop_Writer();
 }
 
@@ -44,7 +55,7 @@ void Stats_Aggregator::Start_Writer()
     auto pname = m_output_pathname + ".iteration.csv";
     BOOST_LOG_TRIVIAL(debug) << "Opening " << pname;
     fout.open( pname.c_str() );
-    fout << "SectorId,NumWaypoints,Iteration,BestFitness,IterationTimeSec" << std::endl;
+    fout << "SectorId,NumWaypoints,Iteration,BestFitness,IterationTimeSec,Event" << std::endl;
     fout.close();
 
     // Write the initial duplicate file
@@ -54,6 +65,13 @@ void Stats_Aggregator::Start_Writer()
     fout << "SectorId,NumWaypoints,Iteration,NumberDuplicates" << std::endl;
     fout.close();
 
+    // Write the initial job cost file
+    pname = m_output_pathname + ".jobs.csv";
+    BOOST_LOG_TRIVIAL(debug) << "Opening " << pname;
+    fout.open( pname.c_str() );
+    fout << "SectorId,NumWaypoints,Iterations,PointUnits,SegmentUnits,PredictedSec,ActualSec" << std::endl;
+    fout.close();
+
     // Start the main thread
     m_okay_to_run = true;
     m_write_thread = std::thread( &Stats_Aggregator::Write_Stats_Info, this );
@@ -81,6 +99,16 @@ void Stats_Aggregator::Report_Timing( const std::string&  subsystem,
     m_timing_info[subsystem].Insert( elapsed_time );
 }
 
+/****************************************************/
+/*          Get the Timing Sample Count             */
+/****************************************************/
+size_t Stats_Aggregator::Get_Timing_Count( const std::string& subsystem ) const
+{
+    std::lock_guard<std::mutex> lck(m_timing_mtx);
+    auto it = m_timing_info.find( subsystem );
+    return ( it == m_timing_info.end() ) ? 0 : it->second.Get_Count();
+}
+
 /****************************************************/
 /*          Report Iteration Information            */
 /****************************************************/
@@ -96,9 +124,28 @@ void Stats_Aggregator::Report_Iteration_Complete( const std::string& sector_id,
                              << iteration_number << ", Fitness: " << best_fitness 
                              << std::fixed << ", Time: " << iteration_time_ms;
 
-    // Create new file entry [SectorId,NumWaypoints,Iteration,BestFitness,IterationTimeSec]
+    // Create new file entry [SectorId,NumWaypoints,Iteration,BestFitness,IterationTimeSec,Event]
     std::stringstream sout;
-    sout << sector_id << "," << num_waypoints << "," << iteration_number << "," << std::fixed << best_fitness << "," << iteration_time_ms;
+    sout << sector_id << "," << num_waypoints << "," << iteration_number << "," << std::fixed << best_fitness << "," << iteration_time_ms << ",";
+    m_iteration_info.push_back(sout.str());
+}
+
+/****************************************************/
+/*          Report the Sweep Stopping Early         */
+/****************************************************/
+void Stats_Aggregator::Report_Sweep_Stop( const std::string& sector_id,
+                                          size_t             num_waypoints,
+                                          double             best_fitness,
+                                          double             improvement )
+{
+    std::lock_guard<std::mutex> lck(m_iter_mtx);
+    BOOST_LOG_TRIVIAL(info) << "Sweep Plateau. Sector: " << sector_id << ", Waypoints: " << num_waypoints
+                            << std::fixed << ", Fitness: " << best_fitness << ", Improvement: " << improvement
+                            << ", Skipping Higher Waypoint Counts";
+
+    // Event row, no iteration or timing [SectorId,NumWaypoints,Iteration,BestFitness,IterationTimeSec,Event]
+    std::stringstream sout;
+    sout << sector_id << "," << num_waypoints << ",," << std::fixed << best_fitness << ",,SweepStop";
     m_iteration_info.push_back(sout.str());
 }
 
@@ -118,13 +165,66 @@ void Stats_Aggregator::Report_Duplicate_Entry( const std::string& sector_id,
     m_duplicate_info.push_back(sout.str());
 }
 
+/********************************************/
+/*          Report the Cost of a Job        */
+/********************************************/
+void Stats_Aggregator::Report_Job_Cost( const std::string& sector_id,
+                                        size_t             num_waypoints,
+                                        size_t             number_iterations,
+                                        double             point_units,
+                                        double             segment_units,
+                                        double             predicted_sec,
+                                        double             actual_sec )
+{
+    std::lock_guard<std::mutex> lck(m_job_mtx);
+    BOOST_LOG_TRIVIAL(info) << "Job Complete. Sector: " << sector_id << ", Waypoints: " << num_waypoints << ", Iterations: " << number_iterations
+                            << std::fixed << ", Predicted: " << predicted_sec << " sec, Actual: " << actual_sec << " sec";
+
+    // Create new file entry [SectorId,NumWaypoints,Iterations,PointUnits,SegmentUnits,PredictedSec,ActualSec]
+    std::stringstream sout;
+    sout << sector_id << "," << num_waypoints << "," << number_iterations << "," << std::fixed << point_units << "," << segment_units << ","
+         << predicted_sec << "," << actual_sec;
+    m_job_info.push_back(sout.str());
+
+    m_job_costs.push_back( Job_Cost{ num_waypoints + 1, point_units, segment_units, actual_sec } );
+}
+
+/****************************************************/
+/*          Report Fitness Cache Counters           */
+/****************************************************/
+void Stats_Aggregator::Report_Fitness_Cache( const std::string& sector_id,
+                                             size_t             num_waypoints,
+                                             size_t             hits,
+                                             size_t             misses,
+                                             size_t             filtered )
+{
+    std::lock_guard<std::mutex> lck(m_cache_mtx);
+    BOOST_LOG_TRIVIAL(debug) << "Fitness Cache. Sector: " << sector_id << ", Waypoints: " << num_waypoints
+                             << ", Hits: " << hits << ", Misses: " << misses << ", Bloom Filtered: " << filtered;
+    m_cache_hits     += hits;
+    m_cache_misses   += misses;
+    m_cache_filtered += filtered;
+}
+
+/****************************************************/
+/*          Get the Reported Job Costs              */
+/****************************************************/
+std::vector<Stats_Aggregator::Job_Cost> Stats_Aggregator::Get_Job_Costs() const
+{
+    std::lock_guard<std::mutex> lck(m_job_mtx);
+    return m_job_costs;
+}
+
 /****************************************/
 /*          Write Stats Info            */
 /****************************************/
 void Stats_Aggregator::Write_Stats_Info()
 {
-    while( m_okay_to_run )
+    // Check the flag before each cycle, so the entries reported before Stop_Writer get one last pass
+    bool running = true;
+    while( running )
     {
+        running = m_okay_to_run;
         BOOST_LOG_TRIVIAL(debug) << "Starting File Write Cycle";
         // Write Iteration Info
         {
@@ -178,8 +278,28 @@ void Stats_Aggregator::Write_Stats_Info()
             }
         }
 
+        // Write Job Cost Info
+        {
+            std::lock_guard<std::mutex> lck(m_job_mtx);
+            if( !m_job_info.empty() )
+            {
+                std::ofstream fout;
+                auto pname = m_output_pathname + ".jobs.csv";
+                fout.open( pname.c_str(), std::ios_base::app );
+                while( !m_job_info.empty() )
+                {
+                    fout << m_job_info.front() << std::endl;
+                    m_job_info.pop_front();
+                }
+                fout.close();
+            }
+        }
+
         // Sleep for a bit
-        std::this_thread::sleep_for( std::chrono::seconds(5) );
+        if( running )
+        {
+            std::this_thread::sleep_for( std::chrono::seconds(5) );
+        }
     }
     BOOST_LOG_TRIVIAL(debug) << "Closing Stats Write Queue";
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #pragma once
 
 // C++ Libraries
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <deque>
@@ -14,6 +15,7 @@
 #include <string>
 #include <thread>
 #include <tuple>
+#include <vector>
 
 // Project Libraries
 #include "Accumulator.hpp"
@@ -25,6 +27,17 @@ class Stats_Aggregator
 {
     public:
 
+        /**
+         * @brief Size and run time of a finished GA job (See Cost_Model::Job_Size)
+         */
+        struct Job_Cost
+        {
+            size_t number_segments;
+            double point_units;
+            double segment_units;
+            double actual_sec;
+        };
+
         /**
          * @brief Constructor
          */
@@ -45,6 +58,11 @@ class Stats_Aggregator
         void Report_Timing( const std::string&  subsystem,
                             double              elapsed_time );
 
+        /**
+         * @brief Get the number of timing samples reported for a subsystem
+         */
+        size_t Get_Timing_Count( const std::string& subsystem ) const;
+
         /**
          * @brief Report end of a cycle.
          */
@@ -54,6 +72,15 @@ class Stats_Aggregator
                                         double             best_fitness,
                                         double             iteration_time_ms );
 
+        /**
+         * @brief Report a sector's waypoint sweep stopping early.
+         * @param improvement Relative fitness improvement of the last waypoint added
+         */
+        void Report_Sweep_Stop( const std::string& sector_id,
+                                size_t             num_waypoints,
+                                double             best_fitness,
+                                double             improvement );
+
         /**
          * @brief Report a duplicate entry.
          */
@@ -62,6 +89,36 @@ class Stats_Aggregator
                                      size_t             iteration_number,
                                      size_t             number_duplicates );
 
+        /**
+         * @brief Report the fitness cache counters of a finished GA run.
+         * @param filtered Misses answered by the Bloom filter alone
+         */
+        void Report_Fitness_Cache( const std::string& sector_id,
+                                   size_t             num_waypoints,
+                                   size_t             hits,
+                                   size_t             misses,
+                                   size_t             filtered );
+
+        /**
+         * @brief Report the predicted and actual run time of a GA job.
+         * @param number_iterations Generations actually run (Fewer than the max on an early exit)
+         * @param point_units Points scored over the run (See Cost_Model::Work_Units)
+         * @param segment_units Point-segment pairs scored over the run
+         * @param predicted_sec Run time predicted before the run, for the max generations
+         */
+        void Report_Job_Cost( const std::string& sector_id,
+                              size_t             num_waypoints,
+                              size_t             number_iterations,
+                              double             point_units,
+                              double             segment_units,
+                              double             predicted_sec,
+                              double             actual_sec );
+
+        /**
+         * @brief Get every reported job, in the order they finished
+         */
+        std::vector<Job_Cost> Get_Job_Costs() const;
+
     private:
 
         /**
@@ -81,13 +138,24 @@ class Stats_Aggregator
         /// Duplicate Tracker
         std::deque<std::string> m_duplicate_info;
 
+        /// Job Cost Tracker [sector_id, NumWaypoints, PointUnits, SegmentUnits, Predicted, Actual]
+        std::deque<std::string> m_job_info;
+        std::vector<Job_Cost> m_job_costs;
+
+        /// Fitness Cache Counters (Totals over every GA run)
+        size_t m_cache_hits { 0 };
+        size_t m_cache_misses { 0 };
+        size_t m_cache_filtered { 0 };
+
         /// Access Lock
         mutable std::mutex m_timing_mtx;
         mutable std::mutex m_iter_mtx;
         mutable std::mutex m_dup_mtx;
+        mutable std::mutex m_job_mtx;
+        mutable std::mutex m_cache_mtx;
 
         /// Write Thread
         std::thread m_write_thread;
-        bool m_okay_to_run { true };
+        std::atomic_bool m_okay_to_run { true };
 
 }; // End of Stats_Aggregator Class
\ No newline at end of file
@@ -5,13 +5,22 @@
  * 
  * @note I stole this entirely from: 
  *       https://vorbrodt.blog/2019/02/27/advanced-thread-pool/
+ *
+ *       Changed so idle workers sleep on a pool-wide signal instead of their own
+ *       queue.  Otherwise work pushed onto a busy worker's queue sits there while
+ *       the other workers are asleep.
  */
+#pragma once
 
 // C++ Libraries
 #include <atomic>
 #include <cassert>
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
 #include <functional>
 #include <future>
+#include <memory>
 #include <thread>
 #include <vector>
 
@@ -20,6 +29,9 @@
 
 /**
  * @class Thread_Pool
+ *
+ * Meant to be long-lived.  Construct one per process and hand it to whoever
+ * needs workers, then use parallel_for / run_batch as the barrier instead of the destructor.
  */
 class Thread_Pool
 {
@@ -38,8 +50,16 @@ class Thread_Pool
                     for(auto n = 0; n < m_count * K; ++n)
                         if(m_queues[(i + n) % m_count].try_pop(f))
                             break;
-                    if(!f && !m_queues[i].pop(f))
-                        break;
+                    if(!f)
+                    {
+                        // Nothing we could grab, so sleep until something is queued anywhere
+                        std::unique_lock lock(m_wake_mutex);
+                        m_wake.wait(lock, [this]() { return m_pending > 0 || m_stopping; });
+                        if(m_pending == 0 && m_stopping)
+                            break;
+                        continue;
+                    }
+                    --m_pending;
                     f();
                 }
             };
@@ -50,8 +70,11 @@ class Thread_Pool
 
         ~Thread_Pool()
         {
-            for(auto& queue : m_queues)
-                queue.done();
+            {
+                std::unique_lock lock(m_wake_mutex);
+                m_stopping = true;
+            }
+            m_wake.notify_all();
             for(auto& thread : m_threads)
                 thread.join();
         }
@@ -60,13 +83,7 @@ class Thread_Pool
         void enqueue_work(F&& f, Args&&... args)
         {
             auto work = [p = std::forward<F>(f), t = std::make_tuple(std::forward<Args>(args)...)]() { std::apply(p, t); };
-            auto i = m_index++;
-
-            for(auto n = 0; n < m_count * K; ++n)
-                if(m_queues[(i + n) % m_count].try_push(work))
-                    return;
-
-            m_queues[i % m_count].push(std::move(work));
+            push_work(std::move(work));
         }
 
         template<typename F, typename... Args>
@@ -78,23 +95,143 @@ class Thread_Pool
             auto task = std::make_shared<task_type>(std::bind(std::forward<F>(f), std::forward<Args>(args)...));
             auto work = [task]() { (*task)(); };
             auto result = task->get_future();
-            auto i = m_index++;
+            push_work(std::move(work));
 
-            for(auto n = 0; n < m_count * K; ++n)
-                if(m_queues[(i + n) % m_count].try_push(work))
-                    return result;
+            return result;
+        }
 
-            m_queues[i % m_count].push(std::move(work));
+        /**
+         * @brief Run fn(i) for every i in [begin,end) and block until all of them finish.
+         *
+         * The range is cut into chunks of `grain` indices (0 picks a size giving each
+         * worker a few chunks).  At most one queue entry is made per worker; workers and
+         * the calling thread then pull chunks off a shared counter, so there is no
+         * per-index allocation or locking.  The first exception thrown by fn stops the
+         * remaining chunks and is rethrown here.
+         *
+         * Safe to call from one of this pool's own workers (e.g. a scheduled job).  The
+         * caller never waits on helpers that have not started yet; those find the loop
+         * closed and return right away.
+         */
+        template<typename F>
+        void parallel_for(size_t begin, size_t end, size_t grain, F&& fn)
+        {
+            if(begin >= end)
+                return;
+            const size_t count = end - begin;
+            if(grain == 0)
+                grain = std::max<size_t>(1, count / (4 * m_count));
 
-            return result;
+            auto state = std::make_shared<Loop_State>();
+            state->number_chunks = (count + grain - 1) / grain;
+
+            auto run_chunks = [&fn, begin, end, grain, st = state.get()]()
+            {
+                for(size_t chunk = st->next_chunk++; chunk < st->number_chunks; chunk = st->next_chunk++)
+                {
+                    try
+                    {
+                        const size_t chunk_end = std::min(end, begin + (chunk + 1) * grain);
+                        for(size_t i = begin + chunk * grain; i < chunk_end; ++i)
+                            fn(i);
+                    }
+                    catch(...)
+                    {
+                        std::unique_lock lock(st->mutex);
+                        if(!st->error)
+                            st->error = std::current_exception();
+                        st->next_chunk = st->number_chunks;
+                    }
+                }
+            };
+
+            // The caller works too, so only number_chunks-1 helpers are ever useful
+            const size_t number_helpers = std::min<size_t>(m_count, state->number_chunks - 1);
+            for(size_t h = 0; h < number_helpers; ++h)
+            {
+                enqueue_work([state, &run_chunks]()
+                {
+                    {
+                        std::unique_lock lock(state->mutex);
+                        if(state->closed)
+                            return;
+                        state->active_helpers++;
+                    }
+                    run_chunks();
+                    std::unique_lock lock(state->mutex);
+                    if(--state->active_helpers == 0)
+                        state->idle.notify_all();
+                });
+            }
+            run_chunks();
+
+            // Every chunk is claimed, so only wait for the helpers still running one
+            std::unique_lock lock(state->mutex);
+            state->closed = true;
+            state->idle.wait(lock, [&state]() { return state->active_helpers == 0; });
+
+            if(state->error)
+                std::rethrow_exception(state->error);
+        }
+
+        /**
+         * @brief Run task(i) for every i in [0,number_tasks) and block until all of them finish.
+         */
+        template<typename F>
+        void run_batch(size_t number_tasks, F&& task)
+        {
+            parallel_for(0, number_tasks, 1, std::forward<F>(task));
+        }
+
+        /**
+         * @brief Number of worker threads
+         */
+        unsigned int size() const
+        {
+            return m_count;
         }
 
     private:
+
+        /// Shared between a parallel_for caller and its helpers
+        struct Loop_State
+        {
+            std::atomic_size_t next_chunk = 0;
+            size_t number_chunks = 0;
+            std::mutex mutex;
+            std::condition_variable idle;
+            size_t active_helpers = 0;
+            bool closed = false;
+            std::exception_ptr error;
+        };
+
         using Proc = std::function<void(void)>;
         using Queue = Blocking_Queue<Proc>;
         using Queues = std::vector<Queue>;
         Queues m_queues;
 
+        void push_work(Proc work)
+        {
+            auto i = m_index++;
+            bool pushed = false;
+            for(auto n = 0; n < m_count * K && !pushed; ++n)
+                pushed = m_queues[(i + n) % m_count].try_push(work);
+            if(!pushed)
+                m_queues[i % m_count].push(std::move(work));
+
+            {
+                std::unique_lock lock(m_wake_mutex);
+                ++m_pending;
+            }
+            m_wake.notify_one();
+        }
+
+        /// Queued but not yet started work, across every queue.  Raised under m_wake_mutex.
+        std::atomic_long m_pending = 0;
+        std::mutex m_wake_mutex;
+        std::condition_variable m_wake;
+        bool m_stopping = false;
+
         using Threads = std::vector<std::thread>;
         Threads m_threads;
 
@@ -7,11 +7,12 @@
 
 // Project Libraries
 #include "Accumulator.hpp"
-#include "Context.hpp"
+#include "Fitness_Engine.hpp"
 #include "Geometry.hpp"
 
 // C++ Libraries
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <chrono>
 #include <cmath>
@@ -19,13 +20,80 @@
 #include <iomanip>
 #include <iostream>
 #include <limits>
-#include <random>
+#include <numeric>
 #include <set>
 #include <sstream>
 
 // Boost Libraries
 #include <boost/log/trivial.hpp>
-#include <boost/stacktrace.hpp>
+
+/****************************************************/
+/*          Clamp a Coordinate to [0,max_value)     */
+/****************************************************/
+static WaypointList::coord_tp To_Coordinate( double value,
+                                             size_t max_value )
+{
+    return std::clamp<double>( value, 0, max_value - 1 );
+}
+
+/****************************************************/
+/*          Bits Needed to Span [0,max_value)       */
+/****************************************************/
+static size_t Range_Bits( size_t max_value )
+{
+    size_t bits = 1;
+    while( bits < 8 * sizeof(WaypointList::coord_tp) && ( size_t(1) << bits ) < max_value )
+    {
+        bits++;
+    }
+    return bits;
+}
+
+/****************************************************/
+/*          Decimal Digits in a DNA Coordinate      */
+/****************************************************/
+static size_t DNA_Digits( size_t max_value )
+{
+    return log10( max_value ) + 1;
+}
+
+/****************************************************/
+/*          Hash One Coordinate of the Genome       */
+/****************************************************/
+static uint64_t Coordinate_Hash( size_t                 coord_idx,
+                                 WaypointList::coord_tp value )
+{
+    // SplitMix64 finalizer over the (position, value) pair
+    uint64_t z = ( (uint64_t)coord_idx << 16 ) + value + 0x9E3779B97F4A7C15ULL;
+    z = ( z ^ ( z >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+    z = ( z ^ ( z >> 27 ) ) * 0x94D049BB133111EBULL;
+    return z ^ ( z >> 31 );
+}
+
+/****************************************/
+/*          Check the Genome Size       */
+/****************************************/
+static void Check_Number_Points( size_t number_points )
+{
+    if( number_points > WaypointList::MAX_WAYPOINTS )
+    {
+        throw std::runtime_error( "Number of waypoints (" + std::to_string( number_points ) +
+                                  ") exceeds the genome capacity (" + std::to_string( WaypointList::MAX_WAYPOINTS ) + ")" );
+    }
+}
+
+/********************************************/
+/*          Check the Coordinate Range      */
+/********************************************/
+void WaypointList::Check_Range( size_t max_x,
+                                size_t max_y )
+{
+    if( max_x < 1 || max_x > MAX_RANGE || max_y < 1 || max_y > MAX_RANGE )
+    {
+        throw std::runtime_error( "Coordinate range (" + std::to_string( max_x ) + " x " + std::to_string( max_y ) +
+                                  ") does not fit the genome (1 to " + std::to_string( MAX_RANGE ) + " per axis)" );
+    }
+}
 
 /********************************/
 /*          Constructor         */
@@ -36,16 +104,32 @@ WaypointList::WaypointList( std::string  dna,
                             size_t       max_y,
                             const Point& start_point,
                             const Point& end_point )
- : m_dna(dna),
-   m_fitness( -1 ),
-   m_number_points(number_points),
-   m_max_x(max_x),
-   m_max_y(max_y),
-   m_x_digits(log10(max_x) + 1),
-   m_y_digits(log10(max_y) + 1),
+ : m_fitness( -1 ),
    m_start_point(start_point),
    m_end_point(end_point)
 {
+    Check_Number_Points( number_points );
+    Check_Range( max_x, max_y );
+    m_max_x = max_x;
+    m_max_y = max_y;
+    m_genome.resize( 2 * number_points );
+    if( dna.size() < Get_DNA_Expected_Size() )
+    {
+        throw std::runtime_error( "DNA strand [" + dna + "] is shorter than the expected " +
+                                  std::to_string( Get_DNA_Expected_Size() ) + " digits" );
+    }
+
+    // Decode the strand once (Digit strings can go past the range, so clamp to it)
+    const size_t x_digits = DNA_Digits( m_max_x );
+    const size_t y_digits = DNA_Digits( m_max_y );
+    for( size_t i=0; i<number_points; i++ )
+    {
+        size_t offset = i * (x_digits + y_digits);
+        m_genome[2*i]   = To_Coordinate( std::stoi( dna.substr( offset, x_digits ) ), m_max_x );
+        m_genome[2*i+1] = To_Coordinate( std::stoi( dna.substr( offset + x_digits, y_digits ) ), m_max_y );
+    }
+    Rehash();
+    Decode_Vertices();
 }
 
 /********************************/
@@ -57,21 +141,33 @@ WaypointList::WaypointList( const std::vector<Point>& waypoints,
                             const Point&              start_point,
                             const Point&              end_point )
  : m_fitness( -1 ),
-   m_number_points(waypoints.size()),
-   m_max_x(max_x),
-   m_max_y(max_y),
-   m_x_digits(log10(max_x) + 1),
-   m_y_digits(log10(max_y) + 1),
    m_start_point(start_point),
    m_end_point(end_point)
 {
-    std::stringstream dna;
-    for( size_t i=0; i<m_number_points; i++ )
+    Check_Number_Points( waypoints.size() );
+    Check_Range( max_x, max_y );
+    m_max_x = max_x;
+    m_max_y = max_y;
+    m_genome.resize( 2 * waypoints.size() );
+    for( size_t i=0; i<waypoints.size(); i++ )
+    {
+        m_genome[2*i]   = To_Coordinate( (int)waypoints[i].x(), m_max_x );
+        m_genome[2*i+1] = To_Coordinate( (int)waypoints[i].y(), m_max_y );
+    }
+    Rehash();
+    Decode_Vertices();
+}
+
+/****************************************/
+/*          Recompute the Hash          */
+/****************************************/
+void WaypointList::Rehash()
+{
+    m_hash = 0;
+    for( size_t coord_idx=0; coord_idx < m_genome.size(); coord_idx++ )
     {
-        dna << std::setfill('0') << std::setw(m_x_digits) << (int)waypoints[i].x();
-        dna << std::setfill('0') << std::setw(m_y_digits) << (int)waypoints[i].y();
+        m_hash ^= Coordinate_Hash( coord_idx, m_genome[coord_idx] );
     }
-    m_dna = dna.str();
 }
 
 /****************************************/
@@ -79,7 +175,15 @@ WaypointList::WaypointList( const std::vector<Point>& waypoints,
 /****************************************/
 std::string WaypointList::Get_DNA() const
 {
-    return m_dna;
+    const size_t x_digits = DNA_Digits( m_max_x );
+    const size_t y_digits = DNA_Digits( m_max_y );
+    std::stringstream dna;
+    for( size_t i=0; i<Get_Number_Waypoint(); i++ )
+    {
+        dna << std::setfill('0') << std::setw(x_digits) << m_genome[2*i];
+        dna << std::setfill('0') << std::setw(y_digits) << m_genome[2*i+1];
+    }
+    return dna.str();
 }
 
 /************************************************************/
@@ -87,7 +191,7 @@ std::string WaypointList::Get_DNA() const
 /************************************************************/
 size_t WaypointList::Get_DNA_Expected_Size() const
 {
-    return (m_number_points * (m_x_digits + m_y_digits) );
+    return ( Get_Number_Waypoint() * ( DNA_Digits( m_max_x ) + DNA_Digits( m_max_y ) ) );
 }
 
 /********************************************/
@@ -109,32 +213,120 @@ void WaypointList::Set_Fitness( double fitness )
 /************************************************************************/
 /*           Update the Fitness Score Against the Point List            */
 /************************************************************************/
-void WaypointList::Update_Fitness( void*             context_info,
+void WaypointList::Update_Fitness( const Context&    context,
                                    bool              check_fitness,
                                    Stats_Aggregator& aggregator )
 {
-    auto start_method = std::chrono::steady_clock::now();
-
     // Skip everything if the fitness is still valid
     if( check_fitness && m_fitness >= 0 )
     {
         return;
     }
+    Compute_Fitness( context, nullptr, 0, aggregator );
+}
 
-    // Cast to the context
-    auto context = *reinterpret_cast<Context*>( context_info );
+/************************************************************************/
+/*           Update the Fitness Score from a Relative's Assignment      */
+/************************************************************************/
+void WaypointList::Update_Fitness( const Context&      context,
+                                   const WaypointList& relative,
+                                   Fitness_State&      state,
+                                   Stats_Aggregator&   aggregator )
+{
+    // The state is only usable if it still belongs to the relative
+    uint64_t moved_waypoints = ~uint64_t(0);
+    if( state.hash == relative.m_hash &&
+        state.point_segments.size() == context.x_list.size() )
+    {
+        moved_waypoints = Get_Moved_Waypoints( relative );
+    }
+    Compute_Fitness( context, &state, moved_waypoints, aggregator );
+}
+
+/************************************************/
+/*          Compare Against Another Genome      */
+/************************************************/
+uint64_t WaypointList::Get_Moved_Waypoints( const WaypointList& relative ) const
+{
+    if( relative.m_genome.size() != m_genome.size() ||
+        relative.m_start_point.x() != m_start_point.x() || relative.m_start_point.y() != m_start_point.y() ||
+        relative.m_end_point.x() != m_end_point.x() || relative.m_end_point.y() != m_end_point.y() )
+    {
+        return ~uint64_t(0);
+    }
 
-    // Get the vertex list
+    uint64_t moved_waypoints = 0;
+    for( size_t i=0; i<Get_Number_Waypoint(); i++ )
+    {
+        if( m_genome[2*i] != relative.m_genome[2*i] || m_genome[2*i+1] != relative.m_genome[2*i+1] )
+        {
+            moved_waypoints |= ( uint64_t(1) << i );
+        }
+    }
+    return moved_waypoints;
+}
+
+/************************************************/
+/*          Count the Moved Waypoints           */
+/************************************************/
+size_t WaypointList::Count_Moved_Waypoints( const WaypointList& relative ) const
+{
+    const uint64_t moved_waypoints = Get_Moved_Waypoints( relative );
+    return ( moved_waypoints == ~uint64_t(0) ) ? Get_Number_Waypoint() : __builtin_popcountll( moved_waypoints );
+}
+
+/************************************************/
+/*          Score the Genome                    */
+/************************************************/
+void WaypointList::Compute_Fitness( const Context&    context,
+                                    Fitness_State*    state,
+                                    uint64_t          moved_waypoints,
+                                    Stats_Aggregator& aggregator )
+{
+    auto start_method = std::chrono::steady_clock::now();
+
+    // Get the vertex list (Already decoded by whatever changed the genome)
     auto start_vert = std::chrono::steady_clock::now();
     auto vertices = Get_Vertices();
     auto stop_vert = std::chrono::duration_cast<std::chrono::microseconds>( std::chrono::steady_clock::now() - start_vert ).count() / 1000000.0;
     aggregator.Report_Timing( "Get_Vertices Method Timing", stop_vert );
 
-    auto start_fit = std::chrono::steady_clock::now();    
-    m_fitness = Fitness_Score_03( context.geo_point_list,
-                                  vertices );
+    auto start_fit = std::chrono::steady_clock::now();
+    auto& engine = Fitness_Engine::Thread_Instance();
+
+    // With the assignment of a close relative, only revisit what the moved waypoints touched.
+    // Waypoint k is vertex k+1, so it ends segment k and starts segment k+1.
+    const uint64_t moved_segments = moved_waypoints | (moved_waypoints << 1);
+    const bool use_delta = state != nullptr &&
+                           moved_waypoints != ~uint64_t(0) &&
+                           Fitness_Engine::Prefers_Reassign( Get_Number_Waypoint() + 1, __builtin_popcountll( moved_segments ) );
+    if( use_delta )
+    {
+        engine.Reassign( context.x_list,
+                         context.y_list,
+                         vertices,
+                         state->point_segments,
+                         moved_segments );
+    }
+    else
+    {
+        engine.Assign( context.x_list,
+                       context.y_list,
+                       vertices );
+        if( state != nullptr )
+        {
+            const auto& point_segments = engine.Get_Point_Segments();
+            state->point_segments.assign( point_segments.begin(), point_segments.end() );
+        }
+    }
+    if( state != nullptr )
+    {
+        state->hash = m_hash;
+    }
+    m_fitness = engine.Score( Fitness_Method::SCORE_03 );
+
     auto stop_fit = std::chrono::duration_cast<std::chrono::microseconds>( std::chrono::steady_clock::now() - start_fit ).count() / 1000000.0;
-    aggregator.Report_Timing( "Direct Fitness Method Timing", stop_fit );
+    aggregator.Report_Timing( use_delta ? "Delta Fitness Method Timing" : "Direct Fitness Method Timing", stop_fit );
 
     auto method_timing = std::chrono::duration_cast<std::chrono::microseconds>( std::chrono::steady_clock::now() - start_method ).count() / 1000000.0;
     aggregator.Report_Timing( "Update_Fitness Method Timing", method_timing );
@@ -173,68 +365,58 @@ Point WaypointList::Get_End_Point() const
 }
 
 /************************************************/
-/*      Get the vertex list from the dna        */
+/*      Get the vertex list from the genome     */
 /************************************************/
-std::vector<Point> WaypointList::Get_Vertices( bool skip_ends ) const
+Span<const Point> WaypointList::Get_Vertices( bool skip_ends ) const
 {
-    std::vector<Point> waypoints;
-    
-    if( !skip_ends )
+    Span<const Point> vertices( m_vertices.data(), m_vertices.size() );
+    if( skip_ends )
     {
-        waypoints.push_back( m_start_point );
+        return vertices.subspan( 1, Get_Number_Waypoint() );
     }
-    for( size_t i=0; i<m_number_points; i++ )
-    {
-        Point temp_pt;
-        try
-        {
-            temp_pt.x() = std::stod(m_dna.substr( i * (m_x_digits + m_y_digits), m_x_digits ));
-        } 
-        catch ( std::exception& e )
-        {
-            BOOST_LOG_TRIVIAL(error) << "Error converting DNA String for X-Value: [" << m_dna << "] Substr: " << i * (m_x_digits + m_y_digits) << " -> " << m_x_digits;
-            BOOST_LOG_TRIVIAL(error) << std::boolalpha << ", Skip-Ends: " << skip_ends;
-            BOOST_LOG_TRIVIAL(error) << boost::stacktrace::stacktrace();
-            std::exit(1);
-        }
-        try
-        {
-            temp_pt.y() = std::stod(m_dna.substr( i * (m_x_digits + m_y_digits) + m_x_digits, m_y_digits ));
-        } 
-        catch ( std::exception& e )
-        {
-            BOOST_LOG_TRIVIAL(error) << "Error converting DNA String for Y-Value: [" << m_dna << "] Substr: " << i * (m_x_digits + m_y_digits) << " -> " << m_x_digits;
-            BOOST_LOG_TRIVIAL(error) << std::boolalpha << ", Skip-Ends: " << skip_ends;
-            BOOST_LOG_TRIVIAL(error) << boost::stacktrace::stacktrace();
-            std::exit(1);
-        }
-        waypoints.push_back( temp_pt );
-    }
-    if( !skip_ends )
+    return vertices;
+}
+
+/************************************************/
+/*      Decode the Genome into Vertices         */
+/************************************************/
+void WaypointList::Decode_Vertices()
+{
+    const size_t number_points = Get_Number_Waypoint();
+    m_vertices.resize( number_points + 2 );
+    m_vertices[0] = m_start_point;
+    for( size_t i=0; i<number_points; i++ )
     {
-        waypoints.push_back( m_end_point );
+        m_vertices[i+1] = ToPoint2D( m_genome[2*i], m_genome[2*i+1] );
     }
-
-    return waypoints;
+    m_vertices[number_points+1] = m_end_point;
 }
 
 /****************************************/
 /*          Randomize Vertices          */
 /****************************************/
-void WaypointList::Randomize_Vertices( const WaypointList& wp )
+void WaypointList::Randomize_Vertices( const WaypointList& wp,
+                                       Random_Generator&   rng )
 {
-    // Get the vertices
-    auto verts = wp.Get_Vertices( true );
+    // Shuffle the waypoints (coordinate pairs) of the source genome (Fisher-Yates)
+    const size_t number_points = wp.Get_Number_Waypoint();
+    std::array<size_t,MAX_WAYPOINTS> order;
+    std::iota( order.begin(), order.begin() + number_points, 0 );
+    for( size_t i = number_points; i > 1; i-- )
+    {
+        std::swap( order[i-1], order[rng.Uniform( i )] );
+    }
 
-    std::shuffle( verts.begin(), verts.end(), std::default_random_engine(std::chrono::system_clock::now().time_since_epoch().count()) );
-    std::stringstream dna;
-    for( size_t i=0; i<wp.m_number_points; i++ )
+    // Built on the side, since wp may be this list
+    genome_tp genome( 2 * number_points );
+    for( size_t i=0; i<number_points; i++ )
     {
-        dna << std::setfill('0') << std::setw(m_x_digits) << verts[i].x();
-        dna << std::setfill('0') << std::setw(m_y_digits) << verts[i].y();
+        genome[2*i]   = wp.m_genome[2*order[i]];
+        genome[2*i+1] = wp.m_genome[2*order[i]+1];
     }
-    m_dna = dna.str();
-    assert( m_dna.size() == dna.str().size() );
+    m_genome.swap( genome );
+    Rehash();
+    Decode_Vertices();
     m_fitness = -1;
 }
 
@@ -251,93 +433,146 @@ bool WaypointList::operator< ( const WaypointList& rhs ) const
 /*****************************************/
 bool WaypointList::operator == ( const WaypointList& rhs ) const
 {
-    return ( m_dna == rhs.m_dna );
+    return ( m_hash == rhs.m_hash &&
+             m_genome == rhs.m_genome );
 }
 
 /****************************************************/
 /*          Create a Random Waypoint List           */
 /****************************************************/
-WaypointList WaypointList::Create_Random( size_t       number_points,
-                                          size_t       max_x,
-                                          size_t       max_y,
-                                          const Point& start_point,
-                                          const Point& end_point )
+WaypointList WaypointList::Create_Random( size_t            number_points,
+                                          size_t            max_x,
+                                          size_t            max_y,
+                                          const Point&      start_point,
+                                          const Point&      end_point,
+                                          Random_Generator& rng )
 {
-    size_t x_digits = log10(max_x) + 1;
-    size_t y_digits = log10(max_y) + 1;
-
-    std::stringstream dna;
-    for( size_t i=0; i<number_points; i++ )
-    {
-        dna << std::setfill('0') << std::setw(x_digits) << (rand() % max_x);
-        dna << std::setfill('0') << std::setw(y_digits) << (rand() % max_y);
-    }
-
-    assert( dna.str().size() == (number_points * (x_digits + y_digits)));
-
-    return WaypointList( dna.str(), 
-                         number_points,
+    WaypointList output( std::vector<Point>( number_points ),
                          max_x,
-                         max_y, 
-                         start_point, 
+                         max_y,
+                         start_point,
                          end_point );
+    Randomize( output, rng );
+    return output;
 }
 
 /********************************************************/
 /*          Perform Crossover on WaypointLists          */
 /********************************************************/
 WaypointList WaypointList::Crossover( const WaypointList& wp1, 
-                                      const WaypointList& wp2 )
+                                      const WaypointList& wp2,
+                                      Random_Generator&   rng )
 {
-    // Find anchor points  (First index cannot be on first position or last to allow second index to work)
-    size_t idx1 = (rand() % (wp1.m_dna.size() - 3) + 1);
-
-    // For now stick with single-point crossover
-    auto output_dna = wp1.m_dna.substr(0, idx1) + wp2.m_dna.substr(idx1);
-    assert( output_dna.size() == wp1.m_dna.size() );
-    return WaypointList( output_dna,
-                         wp1.m_number_points,
+    WaypointList output( std::vector<Point>(),
                          wp1.m_max_x,
                          wp1.m_max_y,
                          wp1.m_start_point,
                          wp1.m_end_point );
+    Crossover_Into( wp1, wp2, output, rng );
+    return output;
+}
+
+/****************************************************************/
+/*          Perform Crossover into an Existing WaypointList     */
+/****************************************************************/
+void WaypointList::Crossover_Into( const WaypointList& wp1,
+                                   const WaypointList& wp2,
+                                   WaypointList&       output,
+                                   Random_Generator&   rng )
+{
+    // Single-point crossover on the bit string.  Pick the coordinate and bit to cut at.
+    const size_t number_coords = wp1.m_genome.size();
+    assert( wp2.m_genome.size() == number_coords );
+    size_t cut_coord = rng.Uniform( number_coords );
+    size_t max_value = ( cut_coord % 2 == 0 ) ? wp1.m_max_x : wp1.m_max_y;
+    size_t cut_bit   = rng.Uniform( Range_Bits( max_value ) );
+
+    // The cut coordinate takes its high bits from the first parent and its low bits from the second
+    const coord_tp low_mask = ( coord_tp(1) << cut_bit ) - 1;
+    coord_tp value = ( wp1.m_genome[cut_coord] & coord_tp(~low_mask) ) | ( wp2.m_genome[cut_coord] & low_mask );
+    if( value >= max_value )
+    {
+        value %= max_value;
+    }
+
+    // Everything before the cut comes from the first parent, everything after from the second.
+    // Written in place, keeping the output's capacity.  The output may be one of the parents,
+    // in which case its own half is already in place.
+    output.m_genome.resize( number_coords );
+    if( &output != &wp1 )
+    {
+        std::copy( wp1.m_genome.begin(),
+                   wp1.m_genome.begin() + cut_coord,
+                   output.m_genome.begin() );
+    }
+    if( &output != &wp2 )
+    {
+        std::copy( wp2.m_genome.begin() + cut_coord + 1,
+                   wp2.m_genome.end(),
+                   output.m_genome.begin() + cut_coord + 1 );
+    }
+    output.m_genome[cut_coord] = value;
+
+    // Everything else comes from the first parent
+    output.m_max_x         = wp1.m_max_x;
+    output.m_max_y         = wp1.m_max_y;
+    output.m_start_point   = wp1.m_start_point;
+    output.m_end_point     = wp1.m_end_point;
+    output.Rehash();
+    output.Decode_Vertices();
+    output.m_fitness = -1;
 }
 
 /****************************************/
 /*          Perform Mutation            */
 /****************************************/
-void WaypointList::Mutation( WaypointList& wp )
+void WaypointList::Mutation( WaypointList&     wp,
+                             Random_Generator& rng )
 {
-    // Pick a single entry to tweak
-    wp.m_dna[rand() % wp.m_dna.size()] = rand() % 10 + '0';
+    // Pick a single coordinate and flip one of the bits needed to span its range
+    size_t coord_idx = rng.Uniform( wp.m_genome.size() );
+    size_t max_value = ( coord_idx % 2 == 0 ) ? wp.m_max_x : wp.m_max_y;
+
+    coord_tp value = wp.m_genome[coord_idx] ^ ( coord_tp(1) << rng.Uniform( Range_Bits( max_value ) ) );
+    if( value >= max_value )
+    {
+        value %= max_value;
+    }
+    wp.m_hash ^= Coordinate_Hash( coord_idx, wp.m_genome[coord_idx] ) ^ Coordinate_Hash( coord_idx, value );
+    wp.m_genome[coord_idx] = value;
+
+    // Only the waypoint holding the coordinate moved (Vertex 0 is the start point)
+    const size_t point_idx = coord_idx / 2;
+    wp.m_vertices[point_idx+1] = ToPoint2D( wp.m_genome[2*point_idx], wp.m_genome[2*point_idx+1] );
     wp.m_fitness = -1;
 }
 
 /*********************************************/
 /*          Perform Randomization            */
 /*********************************************/
-void WaypointList::Randomize( WaypointList& wp )
+void WaypointList::Randomize( WaypointList&     wp,
+                              Random_Generator& rng )
 {
-    std::stringstream dna;
-    for( size_t i=0; i<wp.m_number_points; i++ )
+    for( size_t i=0; i<wp.Get_Number_Waypoint(); i++ )
     {
-        dna << std::setfill('0') << std::setw(wp.m_x_digits) << rand() % wp.m_max_x;
-        dna << std::setfill('0') << std::setw(wp.m_y_digits) << rand() % wp.m_max_y;
+        wp.m_genome[2*i]   = rng.Uniform( wp.m_max_x );
+        wp.m_genome[2*i+1] = rng.Uniform( wp.m_max_y );
     }
-    wp.m_dna = dna.str();
+    wp.Rehash();
+    wp.Decode_Vertices();
     wp.m_fitness = -1;
-    assert( wp.m_dna.size() == wp.Get_DNA_Expected_Size() );
 }
 
 /********************************************************/
 /*          Create a Random Set of Waypoints            */
 /********************************************************/
-std::vector<WaypointList> Build_Random_Waypoints( size_t       population_size,
-                                                  size_t       number_points,
-                                                  size_t       max_x,
-                                                  size_t       max_y,
-                                                  const Point& start_point,
-                                                  const Point& end_point )
+std::vector<WaypointList> Build_Random_Waypoints( size_t            population_size,
+                                                  size_t            number_points,
+                                                  size_t            max_x,
+                                                  size_t            max_y,
+                                                  const Point&      start_point,
+                                                  const Point&      end_point,
+                                                  Random_Generator& rng )
 {
     std::vector<WaypointList> output;
     for( size_t i=0; i<population_size; i++ )
@@ -346,7 +581,8 @@ std::vector<WaypointList> Build_Random_Waypoints( size_t       population_size,
                                                        max_x, 
                                                        max_y,
                                                        start_point,
-                                                       end_point ) );
+                                                       end_point,
+                                                       rng ) );
     }
     return output;
 }
@@ -357,12 +593,11 @@ std::vector<WaypointList> Build_Random_Waypoints( size_t       population_size,
 std::string WaypointList::To_String( bool show_vertices ) const
 {
     std::stringstream sout;
-    sout << "DNA: [" << m_dna << "], Points: [" << m_number_points << "] Fitness: ["  << std::fixed << m_fitness << "]";
+    sout << "DNA: [" << Get_DNA() << "], Points: [" << Get_Number_Waypoint() << "] Fitness: ["  << std::fixed << m_fitness << "]";
     if( show_vertices )
     {
         sout << std::endl;
-        const auto& vertices = Get_Vertices();
-        for( const auto& v : vertices )
+        for( const auto& v : Get_Vertices() )
         {
             std::string extra;
             if( v.x() > m_max_x || v.y() > m_max_y )
@@ -456,7 +691,8 @@ std::map<int,std::vector<WaypointList>> Seed_Population( const std::vector<Point
                                                          size_t                    max_x,
                                                          size_t                    max_y,
                                                          const Point&              start_point,
-                                                         const Point&              end_point )
+                                                         const Point&              end_point,
+                                                         Random_Generator&         rng )
 {
     std::map<int,std::vector<WaypointList>> output;
 
@@ -486,7 +722,7 @@ std::map<int,std::vector<WaypointList>> Seed_Population( const std::vector<Point
                 std::set<size_t> idx_list;
                 while( idx_list.size() < wp )
                 {
-                    idx_list.insert( rand() % dataset_points.size() );
+                    idx_list.insert( rng.Uniform( dataset_points.size() ) );
                 }
 
                 // Build the points
@@ -501,8 +737,10 @@ std::map<int,std::vector<WaypointList>> Seed_Population( const std::vector<Point
                                                             max_x,
                                                             max_y,
                                                             start_point,
-                                                            end_point );
-                vertex_list = temp_wp.Get_Vertices( true );
+                                                            end_point,
+                                                            rng );
+                auto temp_verts = temp_wp.Get_Vertices( true );
+                vertex_list.assign( temp_verts.begin(), temp_verts.end() );
             }
 
             output[wp].emplace_back( vertex_list,
@@ -514,4 +752,43 @@ std::map<int,std::vector<WaypointList>> Seed_Population( const std::vector<Point
     }
 
     return output;
-}
\ No newline at end of file
+}
+/************************************************************/
+/*          Lift a Population to One More Waypoint          */
+/************************************************************/
+std::vector<WaypointList> Lift_Population( const std::vector<WaypointList>& population,
+                                           const Context&                   context )
+{
+    auto& engine = Fitness_Engine::Thread_Instance();
+
+    std::vector<WaypointList> output;
+    output.reserve( population.size() );
+    for( const auto& wp : population )
+    {
+        // Find the segment carrying the most point distance
+        auto vertices = wp.Get_Vertices();
+        engine.Assign( context.x_list,
+                       context.y_list,
+                       vertices );
+        size_t worst_segment = 0;
+        for( size_t seg_idx = 1; seg_idx < engine.Get_Number_Segments(); seg_idx++ )
+        {
+            if( engine.Get_Distance_Sum( seg_idx ) > engine.Get_Distance_Sum( worst_segment ) )
+            {
+                worst_segment = seg_idx;
+            }
+        }
+
+        // Segment k runs from vertex k to k+1, so its midpoint becomes waypoint k
+        std::vector<Point> waypoints( vertices.begin() + 1, vertices.end() - 1 );
+        Point midpoint = vertices[worst_segment] + ( vertices[worst_segment+1] - vertices[worst_segment] ) * 0.5;
+        waypoints.insert( waypoints.begin() + worst_segment, midpoint );
+
+        output.emplace_back( waypoints,
+                             wp.Get_Max_X(),
+                             wp.Get_Max_Y(),
+                             wp.Get_Start_Point(),
+                             wp.Get_End_Point() );
+    }
+    return output;
+}
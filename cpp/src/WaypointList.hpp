@@ -6,40 +6,85 @@
 #pragma once
 
 // C++ Libraries
+#include <cstdint>
 #include <filesystem>
 #include <functional>
+#include <limits>
 #include <string>
 #include <vector>
 
 // Project Libraries
+#include "Context.hpp"
 #include "Geometry.hpp"
+#include "Random.hpp"
+#include "Span.hpp"
 #include "Stats_Aggregator.hpp"
 
 /**
  * @class WaypointList
  * Phenotype for the Genetic Algorithm
+ *
+ * The genome holds one pair of integer coordinates per waypoint, interleaved as
+ * x0,y0,x1,y1,...  Crossover and mutation work on the coordinate bits directly.
+ * The decimal DNA string is only a formatting view for CSV output and loading.
+ * Every genome carries a 64-bit hash (XOR of one mixed value per coordinate),
+ * which Mutation updates for just the coordinate it changes.  The decoded
+ * vertices are kept in step the same way, so reading them never decodes.
+ * The operators draw from the generator they are handed, never from rand().
  */
 class WaypointList
 {
     public:
 
-        /// Crossover Function Type
-        typedef std::function<WaypointList(const WaypointList&,const WaypointList&)> crossover_func_tp;
+        /// Context Type used for Fitness Computations
+        typedef Context context_tp;
+
+        /// Genome Coordinate Type
+        typedef uint16_t coord_tp;
+
+        /// Max number of waypoints a genome can hold
+        static constexpr size_t MAX_WAYPOINTS = 48;
+
+        /// Largest coordinate range per axis (Coordinates run from 0 to range-1)
+        static constexpr size_t MAX_RANGE = size_t(std::numeric_limits<coord_tp>::max()) + 1;
+
+        /// Genome Type
+        typedef std::vector<coord_tp> genome_tp;
+
+        /**
+         * @brief Nearest segment per reference point, as left by a fitness update
+         *
+         * Held outside the phenotype (the GA keeps one per population slot), so a
+         * member costs no more than its genome.  Given the state of a close relative,
+         * Update_Fitness only revisits the segments the two genomes disagree on.
+         */
+        struct Fitness_State
+        {
+            /// Hash of the genome the assignment belongs to
+            uint64_t hash { 0 };
+
+            /// Nearest segment per reference point (Empty if there is no assignment)
+            std::vector<uint8_t> point_segments;
+        };
+
+        /// Crossover Function Type (Writes the child into the last argument)
+        typedef std::function<void(const WaypointList&,const WaypointList&,WaypointList&,Random_Generator&)> crossover_func_tp;
         
         /// Mutation Function Type
-        typedef std::function<void(WaypointList&)> mutation_func_tp;
+        typedef std::function<void(WaypointList&,Random_Generator&)> mutation_func_tp;
 
         /// Randomization Function Type
-        typedef std::function<void(WaypointList&)> random_func_tp;
+        typedef std::function<void(WaypointList&,Random_Generator&)> random_func_tp;
 
         /**
          * @brief Build a new Phenotype from the string
-         * @param dna Text to use as dna strand
+         * @param dna Decimal DNA strand (See Get_DNA).  Coordinates past the range are clamped to it.
          * @param number_points Number of points to solve for
          * @param max_x Max X Value for range computation.
          * @param max_y Max Y Value for range computation
          * @param start_point Normalized starting coordinate
          * @param end_point Normalized ending coordinate.
+         * @throws std::runtime_error if max_x or max_y is not in [1,MAX_RANGE]
          */
         WaypointList( std::string  dna,
                       size_t       number_points,
@@ -50,6 +95,8 @@ class WaypointList
 
         /**
          * @brief Create a WaypointList from normalized vertices.
+         * @note Vertices are rounded down and clamped to the range.
+         * @throws std::runtime_error if max_x or max_y is not in [1,MAX_RANGE]
          */
         WaypointList( const std::vector<Point>& waypoints,
                       size_t                    max_x,
@@ -62,14 +109,32 @@ class WaypointList
          */
         size_t Get_Number_Waypoint() const
         {
-            return m_number_points;
+            return m_genome.size() / 2;
         }
 
         /**
-         * @brief Get the DNA String
+         * @brief Format the genome as a zero-padded decimal DNA string
+         * @note Only meant for logging and CSV output.
          */
         std::string Get_DNA() const;
 
+        /**
+         * @brief Get the packed genome coordinates (x0,y0,x1,y1,...)
+         */
+        Span<const coord_tp> Get_Genome() const
+        {
+            return Span<const coord_tp>( m_genome.data(), m_genome.size() );
+        }
+
+        /**
+         * @brief Get the genome hash
+         * @note Equal genomes always have equal hashes.
+         */
+        uint64_t Get_Hash() const
+        {
+            return m_hash;
+        }
+
         /**
          * @brief Get the expected DNA Size
          */
@@ -80,19 +145,57 @@ class WaypointList
          */
         double Get_Fitness() const;
 
+        /**
+         * @brief Check if the genome changed since it was last scored
+         *
+         * New members start dirty.  After that, only Crossover, Mutation and the
+         * Randomize methods make a member dirty (they reset the fitness to -1).
+         * Copies keep the flag of their source.
+         */
+        bool Is_Dirty() const
+        {
+            return m_fitness < 0;
+        }
+
         /**
          * @brief Set the Fitness
-         * @note Only use for testing.
+         * @note Only use for testing, or with a score computed earlier for the same genome.
          */
         void Set_Fitness( double fitness );
 
         /**
          * @brief Compute a new fitness score
+         * @param context Shared, read-only sector data
+         * @param check_fitness Skip the computation if the fitness is still valid
+         * @param aggregator Stats aggregator for timing information
          */
-        void Update_Fitness( void*             context_info,
+        void Update_Fitness( const Context&    context,
                              bool              check_fitness,
                              Stats_Aggregator& aggregator );
 
+        /**
+         * @brief Compute a new fitness score, starting from the assignment of a relative
+         *
+         * If state holds the assignment of relative, only the segments next to waypoints
+         * that differ from it are revisited.  Otherwise this is a full update.  The score
+         * is the same either way.
+         *
+         * @param context Shared, read-only sector data
+         * @param relative Genome with the same waypoint count, e.g. a parent, or this one before mutation
+         * @param state Assignment of the relative on input, of this genome on output
+         * @param aggregator Stats aggregator for timing information
+         */
+        void Update_Fitness( const Context&      context,
+                             const WaypointList& relative,
+                             Fitness_State&      state,
+                             Stats_Aggregator&   aggregator );
+
+        /**
+         * @brief Count the waypoints that differ from another genome
+         * @return Waypoint count if the genomes are not comparable
+         */
+        size_t Count_Moved_Waypoints( const WaypointList& relative ) const;
+
         /**
          * @brief Get the Max X Value
          */
@@ -114,14 +217,23 @@ class WaypointList
         Point Get_End_Point() const;
         
         /**
-         * @brief Get the vertices from the dna strand
+         * @brief Get the vertices decoded from the genome
+         *
+         * Decoded whenever the genome changes, so this is a read and is safe to call
+         * concurrently.  The span stays valid until the next Crossover_Into, Mutation,
+         * Randomize or Randomize_Vertices call on this list.
+         *
+         * @param skip_ends Leave out the start and end points
          */
-        std::vector<Point> Get_Vertices( bool skip_ends = false) const;
+        Span<const Point> Get_Vertices( bool skip_ends = false ) const;
 
         /**
          * @brief Randomize the Vertices
+         * @param wp Waypoint list whose waypoints get shuffled into this one
+         * @param rng Random generator
         */
-        void Randomize_Vertices( const WaypointList& wp );
+        void Randomize_Vertices( const WaypointList& wp,
+                                 Random_Generator&   rng );
 
         /**
          * @brief Convert to loggable string
@@ -141,51 +253,108 @@ class WaypointList
         /**
          * @brief Create a random waypoint list
          */
-        static WaypointList Create_Random( size_t       number_points,
-                                           size_t       max_x,
-                                           size_t       max_y,
-                                           const Point& start_point,
-                                           const Point& end_point );
+        static WaypointList Create_Random( size_t            number_points,
+                                           size_t            max_x,
+                                           size_t            max_y,
+                                           const Point&      start_point,
+                                           const Point&      end_point,
+                                           Random_Generator& rng );
 
         /**
          * @brief Perform Crossover on Waypoint List
          * @param wp1 First waypoint list
          * @param wp2 Second waypoint list
+         * @param rng Random generator
          * @return New waypoint list.
          */
         static WaypointList Crossover( const WaypointList& wp1, 
-                                       const WaypointList& wp2 );
+                                       const WaypointList& wp2,
+                                       Random_Generator&   rng );
+
+        /**
+         * @brief Perform Crossover into an existing Waypoint List
+         *
+         * Same as Crossover, but the child overwrites output in place and keeps its
+         * buffers, so a GA generation can be rebuilt without heap allocations.
+         *
+         * @param wp1 First waypoint list
+         * @param wp2 Second waypoint list
+         * @param output Waypoint list to overwrite with the child
+         * @param rng Random generator
+         */
+        static void Crossover_Into( const WaypointList& wp1,
+                                    const WaypointList& wp2,
+                                    WaypointList&       output,
+                                    Random_Generator&   rng );
 
         /**
          * @brief Perform Mutation on a Waypoint
          */
-        static void Mutation( WaypointList& wp );
+        static void Mutation( WaypointList&     wp,
+                              Random_Generator& rng );
 
         /**
          * @brief Perform Randomization on a Waypoint
          */
-        static void Randomize( WaypointList& wp );
+        static void Randomize( WaypointList&     wp,
+                               Random_Generator& rng );
+
+        /**
+         * @brief Throw if a coordinate range does not fit the genome type
+         */
+        static void Check_Range( size_t max_x,
+                                 size_t max_y );
 
     private:
 
-        // The actual phenotype the GA will use
-        std::string m_dna;
+        /**
+         * @brief Recompute the genome hash from scratch
+         */
+        void Rehash();
+
+        /**
+         * @brief Decode every vertex from the genome, including the start and end points
+         */
+        void Decode_Vertices();
+
+        /**
+         * @brief Get the waypoints that differ from another genome (Bit per waypoint)
+         * @return Every waypoint if the genomes are not comparable
+         */
+        uint64_t Get_Moved_Waypoints( const WaypointList& relative ) const;
+
+        /**
+         * @brief Score the genome, updating state if there is one
+         * @param state Assignment to update, or null for a full update without one
+         * @param moved_waypoints Waypoints that differ from the genome state belongs to
+         */
+        void Compute_Fitness( const Context&    context,
+                              Fitness_State*    state,
+                              uint64_t          moved_waypoints,
+                              Stats_Aggregator& aggregator );
+
+        /// Every segment gets a bit in the moved masks, and an 8-bit id in Fitness_State
+        static_assert( MAX_WAYPOINTS < 64, "Moved waypoint masks are 64 bits" );
+
+        // The actual phenotype the GA will use (Two coordinates per waypoint)
+        genome_tp m_genome;
+
+        /// Genome Hash (Kept in step with m_genome)
+        uint64_t m_hash { 0 };
 
         // The Fitness Score (Lower is better in this GA)
         double m_fitness;
 
-        // Number Points
-        size_t m_number_points;
-
-        /// Precision
-        size_t m_max_x;
-        size_t m_max_y;
-        size_t m_x_digits;
-        size_t m_y_digits;
+        /// Coordinate Range (At most MAX_RANGE)
+        uint32_t m_max_x;
+        uint32_t m_max_y;
 
         Point m_start_point;
         Point m_end_point;
 
+        /// Decoded vertices including start and end points (Kept in step with m_genome)
+        std::vector<Point> m_vertices;
+
 }; // End of the WaypointList Class
 
 /**
@@ -196,13 +365,15 @@ class WaypointList
  * @param max_y Max distance needed for northing
  * @param start_point Starting point in normalized coordinates.
  * @param end_point Ending point in normalized coordinates.
+ * @param rng Random generator
  */
-std::vector<WaypointList> Build_Random_Waypoints( size_t       population_size,
-                                                  size_t       number_points,
-                                                  size_t       max_x,
-                                                  size_t       max_y,
-                                                  const Point& start_point,
-                                                  const Point& end_point );
+std::vector<WaypointList> Build_Random_Waypoints( size_t            population_size,
+                                                  size_t            number_points,
+                                                  size_t            max_x,
+                                                  size_t            max_y,
+                                                  const Point&      start_point,
+                                                  const Point&      end_point,
+                                                  Random_Generator& rng );
 
 /**
  * @brief Logging-friendly way to print the population list
@@ -241,4 +412,19 @@ std::map<int,std::vector<WaypointList>> Seed_Population( const std::vector<Point
                                                          size_t                    max_x,
                                                          size_t                    max_y,
                                                          const Point&              start_point,
-                                                         const Point&              end_point );
+                                                         const Point&              end_point,
+                                                         Random_Generator&         rng );
+
+/**
+ * @brief Lift a population to one more waypoint
+ *
+ * Each member gets a new waypoint at the middle of the segment with the largest
+ * residual (summed distance of the points nearest to it).  Apart from rounding the
+ * new waypoint to the genome grid, the route does not change, so the result starts
+ * out about as fit as its source.
+ *
+ * @param population Population to lift (Typically the elite of a finished run)
+ * @param context Sector data used to find the residuals
+ */
+std::vector<WaypointList> Lift_Population( const std::vector<WaypointList>& population,
+                                           const Context&                   context );
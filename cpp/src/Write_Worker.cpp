@@ -13,10 +13,13 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 
 // Boost Libraries
 #include <boost/log/trivial.hpp>
 
+static std::mutex write_mtx;
+
 /********************************/
 /*          Constructor         */
 /********************************/
@@ -38,16 +41,19 @@ void Write_Worker::Write( const WaypointList& wp,
                           const std::string&  sector_id,
                           size_t              iteration )
 {
+    // Jobs from every sector share the master list and output files
+    std::lock_guard<std::mutex> lck( write_mtx );
+
     // Store the results of this run
     std::vector<DB_Point> vertex_point_list;
-    auto vertices = wp.Get_Vertices();
-    for( auto& v : vertices )
+    for( const auto& vertex : wp.Get_Vertices() )
     {
         DB_Point new_point;
         new_point.datasetId = wp.Get_DNA();
         new_point.index     = iteration;
 
         // Add the UTM offsets
+        Point v = vertex;
         v += ToPoint2D( std::get<0>(m_point_range), std::get<1>(m_point_range) );
         new_point.gz       = m_utm_gz;
         new_point.easting  = v.x();
@@ -5,8 +5,11 @@
  */
 
 // Project Libraries
+#include "Cost_Model.hpp"
 #include "DB_Utils.hpp"
+#include "Distance_Kernels.hpp"
 #include "GDAL_Utilities.hpp"
+#include "Job_Scheduler.hpp"
 #include "Options.hpp"
 #include "Sector_Runner.hpp"
 
@@ -17,17 +20,17 @@ using namespace std::placeholders;
 
 int main( int argc, char* argv[] )
 {
-    // Overhead
-    srand(time(nullptr));
-
     // Check Command-Line Arguments
     auto options = Parse_Command_Line( argc, argv );
+    BOOST_LOG_TRIVIAL(info) << "Random Seed: " << options.random_seed << " (Pass -seed " << options.random_seed << " to repeat this run)";
+    BOOST_LOG_TRIVIAL(info) << "Distance kernels using instruction set: " << To_String( Get_Active_Instruction_Set() );
     
     // Load the database
     auto db = Open_Database( options.db_path );
 
     // Load the list of sectors
     auto sector_ids = Load_Sector_Data( db );
+    auto sector_point_counts = Load_Sector_Point_Counts( db );
 
     if( options.sector_id >= 0 )
     {
@@ -42,7 +45,7 @@ int main( int argc, char* argv[] )
     }
    
     // Define our mutation and crossover algorithms
-    WaypointList::crossover_func_tp crossover_algorithm = WaypointList::Crossover;
+    WaypointList::crossover_func_tp crossover_algorithm = WaypointList::Crossover_Into;
     WaypointList::mutation_func_tp  mutation_algorithm  = WaypointList::Mutation;
     WaypointList::random_func_tp    random_algorithm    = WaypointList::Randomize;
 
@@ -54,19 +57,26 @@ int main( int argc, char* argv[] )
     Stats_Aggregator stats_aggregator( options.ga_config.stats_output_pathname );
     stats_aggregator.Start_Writer();
 
+    // Every (sector, waypoint-count) GA run shares one bounded set of workers
+    Job_Scheduler scheduler( options.cpu_budget );
+    BOOST_LOG_TRIVIAL(info) << "Job scheduler worker threads: " << scheduler.Get_Number_Threads();
+
+    // Job costs start from the default prices and are refit to the reported run times
+    Cost_Model cost_model( stats_aggregator );
+
     // Master List of Vertices
     Write_Worker::VTX_LIST_TP master_vertex_list;
 
     std::vector<Sector_Runner::ptr_t> runners;
-    std::vector<std::thread> run_threads;
 
-    size_t counter = 0;
     // Iterate over each sector
     for( const auto& sector_id : sector_ids )
     {
         runners.push_back( std::make_shared<Sector_Runner>( db, 
                                                             sector_id.first,
                                                             sector_id.second,
+                                                            sector_point_counts[sector_id.first],
+                                                            cost_model,
                                                             options,
                                                             xform_utm2dd,
                                                             xform_dd2utm,
@@ -75,22 +85,19 @@ int main( int argc, char* argv[] )
                                                             mutation_algorithm,
                                                             random_algorithm,
                                                             stats_aggregator ) );
-        run_threads.emplace_back( &Sector_Runner::Run, runners[counter].get() );
-        counter++;
-    } // Let the destructor finish
+        runners.back()->Start( scheduler );
+    }
 
     // Wait for all work to complete
-    for( auto& runner : runners )
+    try
     {
-        runner->Wait_Completion();
+        scheduler.Wait_All();
     }
-
-    for( auto& thread : run_threads )
+    catch( std::exception& e )
     {
-        if( thread.joinable() )
-        {
-            thread.join();
-        }
+        BOOST_LOG_TRIVIAL(error) << "Caught Exception: " << e.what();
+        sqlite3_close(db);
+        return 1;
     }
     BOOST_LOG_TRIVIAL(debug) << "All Tasks Finished";
 
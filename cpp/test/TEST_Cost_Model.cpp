@@ -0,0 +1,100 @@
+/**
+ * @file    TEST_Cost_Model.cpp
+ * @author  Marvin Smith
+ * @date    1/16/2021
+ */
+#include <gtest/gtest.h>
+
+// Project Libraries
+#include "../src/Cost_Model.hpp"
+#include "../src/Stats_Aggregator.hpp"
+
+/*******************************************************/
+/*          Report a Job Run at the Given Prices       */
+/*******************************************************/
+static void Report_Job( Stats_Aggregator&         aggregator,
+                        size_t                    number_points,
+                        size_t                    number_waypoints,
+                        const Cost_Model::Prices& prices )
+{
+    auto job_size = Cost_Model::Work_Units( number_points, number_waypoints, 100, 50 );
+    double actual_sec = job_size.point_units * prices.seconds_per_point +
+                        job_size.segment_units * prices.seconds_per_segment;
+    aggregator.Report_Job_Cost( "sector_0", number_waypoints, 50, job_size.point_units, job_size.segment_units, 0, actual_sec );
+}
+
+/*************************************************/
+/*          Test the Job Size Terms              */
+/*************************************************/
+TEST( Cost_Model, Work_Units )
+{
+    auto job_size = Cost_Model::Work_Units( 1000, 5, 100, 50 );
+    ASSERT_EQ( job_size.number_segments, 6 );
+    ASSERT_DOUBLE_EQ( job_size.point_units, 1000.0 * 100 * 50 );
+    ASSERT_DOUBLE_EQ( job_size.segment_units, 1000.0 * 6 * 100 * 50 );
+
+    // Before any job finishes, the priors price the job
+    Stats_Aggregator aggregator( "junk_path" );
+    Cost_Model cost_model( aggregator );
+    const auto& prior = Cost_Model::DEFAULT_SCAN_PRICES;
+    ASSERT_DOUBLE_EQ( cost_model.Predict_Seconds( job_size ),
+                      job_size.point_units * prior.seconds_per_point + job_size.segment_units * prior.seconds_per_segment );
+}
+
+/*************************************************/
+/*          Test Refitting to Reported Jobs      */
+/*************************************************/
+TEST( Cost_Model, Fit_Prices )
+{
+    Stats_Aggregator aggregator( "junk_path" );
+    Cost_Model cost_model( aggregator );
+
+    // One route length cannot split the terms, so the prior split is scaled to match
+    const Cost_Model::Prices scan_prices { 2e-8, 1e-10 };
+    Report_Job( aggregator, 1500, 4, scan_prices );
+    auto prices = cost_model.Get_Prices( 5 );
+    const auto& prior = Cost_Model::DEFAULT_SCAN_PRICES;
+    ASSERT_NEAR( prices.seconds_per_point / prices.seconds_per_segment,
+                 prior.seconds_per_point / prior.seconds_per_segment,
+                 1e-6 * prior.seconds_per_point / prior.seconds_per_segment );
+    auto job_size = Cost_Model::Work_Units( 1500, 4, 100, 50 );
+    ASSERT_NEAR( cost_model.Predict_Seconds( job_size ),
+                 job_size.point_units * scan_prices.seconds_per_point + job_size.segment_units * scan_prices.seconds_per_segment,
+                 1e-9 );
+
+    // A second route length recovers both prices
+    Report_Job( aggregator, 2000, 8, scan_prices );
+    Report_Job( aggregator, 800, 2, scan_prices );
+    prices = cost_model.Get_Prices( 5 );
+    ASSERT_NEAR( prices.seconds_per_point, scan_prices.seconds_per_point, 1e-6 * scan_prices.seconds_per_point );
+    ASSERT_NEAR( prices.seconds_per_segment, scan_prices.seconds_per_segment, 1e-6 * scan_prices.seconds_per_segment );
+
+    // Culled routes have no jobs yet, so they keep their prior, corrected for the speed of the machine
+    auto cull_prices = cost_model.Get_Prices( 30 );
+    const auto& cull_prior = Cost_Model::DEFAULT_CULL_PRICES;
+    ASSERT_NEAR( cull_prices.seconds_per_point / cull_prior.seconds_per_point,
+                 cull_prices.seconds_per_segment / cull_prior.seconds_per_segment,
+                 1e-9 );
+    ASSERT_NE( cull_prices.seconds_per_point, cull_prior.seconds_per_point );
+}
+
+/*****************************************************/
+/*          Test that the Fit Can Reorder Jobs       */
+/*****************************************************/
+TEST( Cost_Model, Job_Order )
+{
+    // A big sector with a short route, and a small sector with a long one
+    auto big_sector = Cost_Model::Work_Units( 3000, 2, 100, 50 );
+    auto long_route = Cost_Model::Work_Units( 1000, 10, 100, 50 );
+    ASSERT_LT( big_sector.segment_units, long_route.segment_units );
+
+    // Once the jobs show the per-point work dominates, the big sector goes first
+    Stats_Aggregator aggregator( "junk_path" );
+    Cost_Model cost_model( aggregator, Cost_Model::Prices{ 1e-10, 1e-9 } );
+    ASSERT_LT( cost_model.Predict_Seconds( big_sector ), cost_model.Predict_Seconds( long_route ) );
+
+    const Cost_Model::Prices scan_prices { 1e-8, 1e-10 };
+    Report_Job( aggregator, 1200, 3, scan_prices );
+    Report_Job( aggregator, 1500, 7, scan_prices );
+    ASSERT_GT( cost_model.Predict_Seconds( big_sector ), cost_model.Predict_Seconds( long_route ) );
+}
@@ -69,6 +69,11 @@ TEST( DB_Utils, Load_Sector_Data )
     ASSERT_NEAR( Point::Distance_L2( std::get<0>(sector_data["sector_0"]).Get_LLA_Coordinate(), ToPoint2D( 39.598926, -104.860817 ) ), 0, 0.001 );
     ASSERT_NEAR( Point::Distance_L2( std::get<1>(sector_data["sector_8"]).Get_LLA_Coordinate(), ToPoint2D( 39.75488375, -105.00005525 ) ), 0, 0.001 );
 
+    // The counts must match what actually gets loaded
+    auto point_counts = Load_Sector_Point_Counts( db );
+    ASSERT_EQ( point_counts.size(), 9 );
+    ASSERT_EQ( point_counts["sector_2"], Load_Point_List( db, "sector_2" ).size() );
+
     // Cleanup
     sqlite3_close(db);
 }
\ No newline at end of file
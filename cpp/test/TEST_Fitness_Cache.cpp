@@ -0,0 +1,72 @@
+/**
+ * @file    TEST_Fitness_Cache.cpp
+ * @author  Marvin Smith
+ * @date    1/14/2021
+ */
+#include <gtest/gtest.h>
+
+// C++ Libraries
+#include <atomic>
+#include <vector>
+
+// Project Libraries
+#include "../src/Fitness_Cache.hpp"
+#include "../src/Thread_Pool.hpp"
+
+/*************************************************/
+/*          Test Lookups and Counters            */
+/*************************************************/
+TEST( Fitness_Cache, Find_Insert )
+{
+    Fitness_Cache cache( 1000 );
+    ASSERT_EQ( cache.Get_Capacity(), 1024 );
+
+    // Nothing inserted yet, so the Bloom filter answers
+    double fitness = 0;
+    ASSERT_FALSE( cache.Find( 0x1234567890ABCDEFULL, fitness ) );
+    ASSERT_EQ( cache.Get_Filtered(), 1 );
+
+    cache.Insert( 0x1234567890ABCDEFULL, 42.5 );
+    ASSERT_TRUE( cache.Find( 0x1234567890ABCDEFULL, fitness ) );
+    ASSERT_EQ( fitness, 42.5 );
+
+    // Same slot, different key: the new score replaces the old one
+    cache.Insert( 0x1234567890ABCDEFULL + 1024 * 64, 7.0 );
+    ASSERT_FALSE( cache.Find( 0x1234567890ABCDEFULL, fitness ) );
+
+    ASSERT_EQ( cache.Get_Hits(), 1 );
+    ASSERT_EQ( cache.Get_Misses(), 2 );
+
+    // A disabled cache never hits and never counts
+    Fitness_Cache disabled( 0 );
+    disabled.Insert( 5, 1.0 );
+    ASSERT_FALSE( disabled.Find( 5, fitness ) );
+    ASSERT_EQ( disabled.Get_Misses(), 0 );
+}
+
+/*************************************************/
+/*          Test Concurrent Access               */
+/*************************************************/
+TEST( Fitness_Cache, Concurrent )
+{
+    // Keys share slots and the Bloom filter resets, but most keys stay resident long enough to hit
+    Fitness_Cache cache( 256 );
+    Thread_Pool pool( 4 );
+    std::atomic_size_t wrong_scores = 0;
+    pool.parallel_for( 0, 200000, 0, [&]( size_t idx ){
+        uint64_t key = ( idx % 200 ) * 0x9E3779B97F4A7C15ULL;
+        double fitness;
+        if( cache.Find( key, fitness ) )
+        {
+            wrong_scores += ( fitness != (double)( idx % 200 ) );
+        }
+        else
+        {
+            cache.Insert( key, idx % 200 );
+        }
+    });
+
+    ASSERT_EQ( wrong_scores, 0 );
+    ASSERT_EQ( cache.Get_Hits() + cache.Get_Misses(), 200000 );
+    ASSERT_GT( cache.Get_Hits(), 0 );
+}
@@ -0,0 +1,48 @@
+/**
+ * @file    TEST_Flat_Hash_Set.cpp
+ * @author  Marvin Smith
+ * @date    1/14/2021
+ */
+#include <gtest/gtest.h>
+
+// C++ Libraries
+#include <set>
+#include <vector>
+
+// Project Libraries
+#include "../src/Flat_Hash_Set.hpp"
+
+/*************************************************/
+/*          Test Against a Reference Set         */
+/*************************************************/
+TEST( Flat_Hash_Set, Insert )
+{
+    Flat_Hash_Set hash_set;
+    std::set<uint64_t> reference;
+
+    // Start small so the table has to grow, and include the empty-slot key
+    hash_set.Reset( 4 );
+    std::vector<uint64_t> keys { 0, 0, 1, 17, 33, 1 };
+    for( int i=0; i<2000; i++ )
+    {
+        keys.push_back( ( (uint64_t)rand() << 32 ) | ( rand() % 500 ) );
+        keys.push_back( rand() % 500 );
+    }
+
+    for( const auto& key : keys )
+    {
+        ASSERT_EQ( hash_set.Insert( key ), reference.insert( key ).second );
+    }
+    ASSERT_EQ( hash_set.Size(), reference.size() );
+    for( const auto& key : keys )
+    {
+        ASSERT_TRUE( hash_set.Contains( key ) );
+    }
+    ASSERT_FALSE( hash_set.Contains( 501 ) );
+
+    // Reset empties it
+    hash_set.Reset( 10 );
+    ASSERT_EQ( hash_set.Size(), 0 );
+    ASSERT_FALSE( hash_set.Contains( 0 ) );
+    ASSERT_FALSE( hash_set.Contains( 17 ) );
+}
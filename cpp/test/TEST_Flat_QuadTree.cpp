@@ -0,0 +1,283 @@
+/**
+ * @file    TEST_Flat_QuadTree.cpp
+ * @author  Marvin Smith
+ * @date    1/17/2021
+*/
+#include <gtest/gtest.h>
+
+// Project Libraries
+#include "../src/DB_Utils.hpp"
+#include "../src/Flat_QuadTree.hpp"
+#include "../src/QuadTree.hpp"
+
+// C++ Libraries
+#include <algorithm>
+#include <exception>
+
+// Boost Libraries
+#include <boost/log/trivial.hpp>
+
+/****************************************************/
+/*          Sample usage of the quad tree           */
+/****************************************************/
+TEST( Flat_QuadTree, Small_Scale_Usage )
+{
+    // Create an empty quad-tree
+    Flat_QuadTree qt( Rect( ToPoint2D(-10, -10), 20, 20 ) );
+
+    // For this test, we need a small, specific set of points
+    size_t counter = 0;
+    for( int i=1; i<=10; i++ )
+    {
+        qt.Insert( counter++, ToPoint2D( -i, -i ) );
+        qt.Insert( counter++, ToPoint2D( -i,  i ) );
+        qt.Insert( counter++, ToPoint2D(  i, -i ) );
+        qt.Insert( counter++, ToPoint2D(  i,  i ) );
+    }
+    ASSERT_EQ( qt.Size(), 40 );
+
+    // Make sure going out of bounds is caught
+    ASSERT_THROW( qt.Insert( counter++, ToPoint2D( 11, 9) ), std::invalid_argument );
+
+    // Query for all nodes inside region
+    ASSERT_EQ( qt.Search( ToPoint2D(  0, 0 ), 1.5 ).size(), 4 ); // Test all of the tree
+    ASSERT_EQ( qt.Search( ToPoint2D( -8, 6 ), 3 ).size(), 3 ); // Test NW Edge of tree
+
+    // Piling points onto one spot fills the max level, then chains buckets
+    for( int i=0; i<50; i++ )
+    {
+        qt.Insert( counter++, ToPoint2D( 2.5, 2.5 ) );
+    }
+    ASSERT_EQ( qt.Search( ToPoint2D( 2.5, 2.5 ), 0.1 ).size(), 50 );
+
+    // Clearing keeps the bounds
+    qt.Clear();
+    ASSERT_EQ( qt.Size(), 0 );
+    ASSERT_EQ( qt.Get_Number_Nodes(), 1 );
+    ASSERT_EQ( qt.Search( ToPoint2D( 0, 0 ), 100 ).size(), 0 );
+}
+
+/****************************************************************/
+/*          Test the Visitor and Existence Queries              */
+/****************************************************************/
+TEST( Flat_QuadTree, Visitor_Queries )
+{
+    Flat_QuadTree qt( Rect( ToPoint2D(-10, -10), 20, 20 ), 2, 5 );
+    size_t counter = 0;
+    for( int i=1; i<=10; i++ )
+    {
+        qt.Insert( counter++, ToPoint2D( -i, -i ) );
+        qt.Insert( counter++, ToPoint2D( -i,  i ) );
+        qt.Insert( counter++, ToPoint2D(  i, -i ) );
+        qt.Insert( counter++, ToPoint2D(  i,  i ) );
+    }
+
+    // The visitor sees exactly what Search returns
+    for( double radius : { 0.5, 1.5, 3.0, 8.0, 30.0 } )
+    {
+        for( const auto& center : { ToPoint2D( 0, 0 ), ToPoint2D( -8, 6 ), ToPoint2D( 5, -5 ) } )
+        {
+            std::vector<size_t> visited;
+            qt.For_Each_Within( center, radius, [&]( size_t id ){ visited.push_back( id ); } );
+            auto searched = qt.Search( center, radius );
+            std::sort( visited.begin(), visited.end() );
+            std::sort( searched.begin(), searched.end() );
+            ASSERT_EQ( visited, searched );
+            ASSERT_EQ( qt.Any_Within( center, radius ), !searched.empty() );
+        }
+    }
+
+    // Radius is exclusive, like Search
+    ASSERT_FALSE( qt.Any_Within( ToPoint2D( 1, 0 ), 1 ) );
+    ASSERT_TRUE( qt.Any_Within( ToPoint2D( 1, 0 ), 1.001 ) );
+}
+
+/****************************************************/
+/*          Build QuadTree with all Points          */
+/****************************************************/
+TEST( Flat_QuadTree, Large_Scale_Usage )
+{
+    // Load the database
+    sqlite3 *db;
+    auto rc = sqlite3_open( "cpp/unit_test_data/bike_data.db", &db );
+    ASSERT_EQ( rc, 0 );
+
+    // For Each Sector, Load the points
+    auto point_list = Load_Point_List( db, "" );
+    ASSERT_GT( point_list.size(), 5000 );
+
+    // Normalize to get standard range
+    auto range = Normalize_Points( point_list );
+
+    // Compute bounding box
+    Rect bbox( ToPoint2D( -10, -10 ),
+               std::get<2>(range) - std::get<0>(range) + 20,
+               std::get<3>(range) - std::get<1>(range) + 20);
+
+    // Create both trees
+    int max_objects = 20;
+    int max_levels = 10;
+    Flat_QuadTree qt( bbox, 
+                      max_objects,
+                      max_levels );
+    QuadTree<QTNode> reference_qt( bbox,
+                                   max_objects,
+                                   max_levels );
+    for( const auto& point : point_list )
+    {
+        qt.Insert( point.index, ToPoint2D( point.x_norm, point.y_norm ) );
+        reference_qt.Insert( std::make_shared<QTNode>( point.index, ToPoint2D( point.x_norm, point.y_norm ) ));
+    }
+
+    // Perform some big queries
+    auto sector_1_stop = ToPoint2D( 511210 - std::get<0>(range),
+                                    4388378 - std::get<1>(range) );
+    auto results = qt.Search( sector_1_stop, 20 );
+    ASSERT_EQ( results.size(), 16 );
+
+    // Exact matches everywhere.  The pointer-based tree can miss points across child
+    // boundaries, so it only has to be a subset.
+    for( size_t i=0; i<point_list.size(); i += 97 )
+    {
+        auto center = ToPoint2D( point_list[i].x_norm + 3, point_list[i].y_norm - 2 );
+        auto ids = qt.Search( center, 25 );
+        std::vector<size_t> expected_ids;
+        for( const auto& point : point_list )
+        {
+            if( Point::Distance_L2( center, ToPoint2D( point.x_norm, point.y_norm ) ) < 25 )
+            {
+                expected_ids.push_back( point.index );
+            }
+        }
+        std::vector<size_t> reference_ids;
+        for( const auto& node : reference_qt.Search( center, 25 ) )
+        {
+            reference_ids.push_back( node->Get_ID() );
+        }
+        std::sort( ids.begin(), ids.end() );
+        std::sort( expected_ids.begin(), expected_ids.end() );
+        std::sort( reference_ids.begin(), reference_ids.end() );
+        ASSERT_EQ( ids, expected_ids );
+        ASSERT_TRUE( std::includes( ids.begin(), ids.end(), reference_ids.begin(), reference_ids.end() ) );
+    }
+
+    // Cleanup
+    sqlite3_close(db);
+}
+
+/****************************************************/
+/*          Bulk-Load Matches One-by-One Insert     */
+/****************************************************/
+TEST( Flat_QuadTree, Build )
+{
+    // Load the database
+    sqlite3 *db;
+    auto rc = sqlite3_open( "cpp/unit_test_data/bike_data.db", &db );
+    ASSERT_EQ( rc, 0 );
+
+    auto point_list = Load_Point_List( db, "" );
+    auto range = Normalize_Points( point_list );
+    Rect bbox( ToPoint2D( -10, -10 ),
+               std::get<2>(range) - std::get<0>(range) + 20,
+               std::get<3>(range) - std::get<1>(range) + 20);
+
+    std::vector<Point> points;
+    for( const auto& point : point_list )
+    {
+        points.push_back( ToPoint2D( point.x_norm, point.y_norm ) );
+    }
+
+    Flat_QuadTree inserted_qt( bbox, 20, 10 );
+    for( size_t i=0; i<points.size(); i++ )
+    {
+        inserted_qt.Insert( i, points[i] );
+    }
+    Flat_QuadTree built_qt( bbox, 20, 10 );
+    built_qt.Build( points );
+
+    // Same structure and the same answers
+    ASSERT_EQ( built_qt.Size(), inserted_qt.Size() );
+    ASSERT_EQ( built_qt.Get_Number_Nodes(), inserted_qt.Get_Number_Nodes() );
+    for( size_t i=0; i<points.size(); i += 53 )
+    {
+        auto center = points[i] + ToPoint2D( 4, 1 );
+        auto built_ids = built_qt.Search( center, 30 );
+        auto inserted_ids = inserted_qt.Search( center, 30 );
+        std::sort( built_ids.begin(), built_ids.end() );
+        std::sort( inserted_ids.begin(), inserted_ids.end() );
+        ASSERT_EQ( built_ids, inserted_ids );
+    }
+
+    // Piles of duplicates and out of bounds points are handled like Insert
+    std::vector<Point> duplicates( 100, ToPoint2D( 5, 5 ) );
+    built_qt.Build( duplicates );
+    ASSERT_EQ( built_qt.Search( ToPoint2D( 5, 5 ), 1 ).size(), 100 );
+    duplicates.push_back( ToPoint2D( -100, 5 ) );
+    ASSERT_THROW( built_qt.Build( duplicates ), std::invalid_argument );
+
+    // Cleanup
+    sqlite3_close(db);
+}
+
+/****************************************************************/
+/*          Compare Nearest Queries against Brute Force         */
+/****************************************************************/
+TEST( Flat_QuadTree, Nearest_Neighbors )
+{
+    // Load the database
+    sqlite3 *db;
+    auto rc = sqlite3_open( "cpp/unit_test_data/bike_data.db", &db );
+    ASSERT_EQ( rc, 0 );
+
+    auto point_list = Load_Point_List( db, "" );
+    auto range = Normalize_Points( point_list );
+    Rect bbox( ToPoint2D( -1000, -1000 ),
+               std::get<2>(range) - std::get<0>(range) + 2000,
+               std::get<3>(range) - std::get<1>(range) + 2000);
+
+    std::vector<Point> points;
+    for( const auto& point : point_list )
+    {
+        points.push_back( ToPoint2D( point.x_norm, point.y_norm ) );
+    }
+
+    Flat_QuadTree qt( bbox, 20, 10 );
+    ASSERT_THROW( qt.Nearest( ToPoint2D( 0, 0 ) ), std::runtime_error );
+    ASSERT_TRUE( qt.Nearest_K( ToPoint2D( 0, 0 ), 5 ).empty() );
+    qt.Build( points );
+
+    // Query on the track, just off it, and well outside the points
+    for( size_t i=0; i<points.size(); i += 97 )
+    {
+        for( const auto& offset : { ToPoint2D( 0, 0 ), ToPoint2D( 7, -3 ), ToPoint2D( -900, 900 ) } )
+        {
+            auto center = points[i] + offset;
+
+            // Brute force, closest first, ties to the lowest id
+            std::vector<std::pair<double,size_t>> expected;
+            for( size_t j=0; j<points.size(); j++ )
+            {
+                auto delta = points[j] - center;
+                expected.emplace_back( delta.x() * delta.x() + delta.y() * delta.y(), j );
+            }
+            std::partial_sort( expected.begin(), expected.begin() + 10, expected.end() );
+
+            ASSERT_EQ( qt.Nearest( center ), expected[0].second );
+            auto nearest = qt.Nearest_K( center, 10 );
+            ASSERT_EQ( nearest.size(), 10 );
+            for( size_t j=0; j<nearest.size(); j++ )
+            {
+                ASSERT_EQ( nearest[j], expected[j].second );
+            }
+        }
+    }
+
+    // Asking for more than there are returns everything
+    Flat_QuadTree small_qt( bbox );
+    small_qt.Insert( 7, ToPoint2D( 1, 1 ) );
+    small_qt.Insert( 3, ToPoint2D( 5, 5 ) );
+    ASSERT_EQ( small_qt.Nearest_K( ToPoint2D( 4, 4 ), 5 ), std::vector<size_t>( { 3, 7 } ) );
+
+    // Cleanup
+    sqlite3_close(db);
+}
@@ -0,0 +1,171 @@
+/**
+ * @file    TEST_Genetic_Algorithm.cpp
+ * @author  Marvin Smith
+ * @date    1/15/2021
+ */
+#include <gtest/gtest.h>
+
+// C++ Libraries
+#include <algorithm>
+#include <limits>
+
+// Project Libraries
+#include "../src/Context.hpp"
+#include "../src/Genetic_Algorithm.hpp"
+#include "../src/Thread_Pool.hpp"
+#include "../src/WaypointList.hpp"
+#include "Utilities.hpp"
+
+// Boost Libraries
+#include <boost/log/trivial.hpp>
+
+/****************************************************************/
+/*          Run a Small GA with Each Selection Method           */
+/****************************************************************/
+TEST( Genetic_Algorithm, Selection_Methods )
+{
+    auto sector = Load_Test_Sector( "sector_2", ToPoint2D( 6, 2 ), ToPoint2D( 546, 1442 ) );
+
+    Stats_Aggregator aggregator( "junk_path" );
+    Thread_Pool thread_pool( 2 );
+    for( size_t tournament_size : { 0, 3 } )
+    {
+        Random_Generator rng( 0 );
+        GA_Config config;
+        config.tournament_size = tournament_size;
+        auto initial_population = Build_Random_Waypoints( 100, 6, sector.max_x, sector.max_y, sector.start_point, sector.end_point, rng );
+
+        // Score the starting point to compare against
+        for( auto& member : initial_population )
+        {
+            member.Update_Fitness( *sector.context, false, aggregator );
+        }
+        auto initial_best = *std::min_element( initial_population.begin(), initial_population.end() );
+
+        Genetic_Algorithm<WaypointList> ga( config,
+                                            initial_population,
+                                            WaypointList::Crossover_Into,
+                                            WaypointList::Mutation,
+                                            WaypointList::Randomize,
+                                            []( const WaypointList&, const std::string&, size_t ){},
+                                            aggregator,
+                                            thread_pool );
+        auto population = ga.Run( "sector_2", sector.context, 20, std::make_shared<Exit_Condition>( 20, 0.001 ) );
+        ASSERT_EQ( ga.Get_Number_Iterations(), 20 );
+
+        // Everything scored, best first, and never worse than where it started
+        ASSERT_EQ( population.size(), initial_population.size() );
+        for( size_t i=0; i<population.size(); i++ )
+        {
+            ASSERT_FALSE( population[i].Is_Dirty() );
+            if( i > 0 )
+            {
+                ASSERT_LE( population[i-1].Get_Fitness(), population[i].Get_Fitness() );
+            }
+        }
+        ASSERT_LE( population.front().Get_Fitness(), initial_best.Get_Fitness() );
+    }
+}
+
+/****************************************************************/
+/*          Count the Generations of a Run that Exits Early     */
+/****************************************************************/
+TEST( Genetic_Algorithm, Early_Exit )
+{
+    auto sector = Load_Test_Sector( "sector_2", ToPoint2D( 6, 2 ), ToPoint2D( 546, 1442 ) );
+
+    Stats_Aggregator aggregator( "junk_path" );
+    Thread_Pool thread_pool( 2 );
+    Random_Generator rng( 0 );
+    GA_Config config;
+    Genetic_Algorithm<WaypointList> ga( config,
+                                        Build_Random_Waypoints( 50, 6, sector.max_x, sector.max_y, sector.start_point, sector.end_point, rng ),
+                                        WaypointList::Crossover_Into,
+                                        WaypointList::Mutation,
+                                        WaypointList::Randomize,
+                                        []( const WaypointList&, const std::string&, size_t ){},
+                                        aggregator,
+                                        thread_pool );
+
+    // Every fitness matches within an infinite tolerance, so the second generation ends the run
+    auto population = ga.Run( "sector_2", sector.context, 20,
+                              std::make_shared<Exit_Condition>( 2, std::numeric_limits<double>::infinity() ) );
+    ASSERT_EQ( ga.Get_Number_Iterations(), 2 );
+    ASSERT_EQ( population.size(), 50 );
+}
+
+/****************************************************************/
+/*          Same Seed, Same Result, Whatever the Threads        */
+/****************************************************************/
+TEST( Genetic_Algorithm, Reproducible )
+{
+    auto sector = Load_Test_Sector( "sector_2", ToPoint2D( 6, 2 ), ToPoint2D( 546, 1442 ) );
+
+    Stats_Aggregator aggregator( "junk_path" );
+    auto run_ga = [&]( unsigned int number_threads, uint64_t seed )
+    {
+        Random_Generator rng( seed );
+        GA_Config config;
+        config.random_seed = seed;
+        Thread_Pool thread_pool( number_threads );
+        Genetic_Algorithm<WaypointList> ga( config,
+                                            Build_Random_Waypoints( 100, 6, sector.max_x, sector.max_y, sector.start_point, sector.end_point, rng ),
+                                            WaypointList::Crossover_Into,
+                                            WaypointList::Mutation,
+                                            WaypointList::Randomize,
+                                            []( const WaypointList&, const std::string&, size_t ){},
+                                            aggregator,
+                                            thread_pool );
+        return ga.Run( "sector_2", sector.context, 10, std::make_shared<Exit_Condition>( 20, 0.001 ) );
+    };
+
+    auto population1 = run_ga( 1, 1234 );
+    auto population2 = run_ga( 4, 1234 );
+    ASSERT_EQ( population1.size(), population2.size() );
+    for( size_t i=0; i<population1.size(); i++ )
+    {
+        ASSERT_EQ( population1[i], population2[i] );
+        ASSERT_EQ( population1[i].Get_Fitness(), population2[i].Get_Fitness() );
+    }
+
+    // A different seed takes a different path
+    auto population3 = run_ga( 4, 4321 );
+    ASSERT_FALSE( population1.front() == population3.front() );
+}
+
+/****************************************************************/
+/*          Offspring Scored from a Parent's Assignment         */
+/****************************************************************/
+TEST( Genetic_Algorithm, Delta_Fitness )
+{
+    auto sector = Load_Test_Sector( "sector_2", ToPoint2D( 6, 2 ), ToPoint2D( 546, 1442 ) );
+
+    // Long routes, so a child that takes after one parent stays incremental
+    Stats_Aggregator aggregator( "junk_path" );
+    Thread_Pool thread_pool( 2 );
+    Random_Generator rng( 0 );
+    GA_Config config;
+    Genetic_Algorithm<WaypointList> ga( config,
+                                        Build_Random_Waypoints( 100, 30, sector.max_x, sector.max_y, sector.start_point, sector.end_point, rng ),
+                                        WaypointList::Crossover_Into,
+                                        WaypointList::Mutation,
+                                        WaypointList::Randomize,
+                                        []( const WaypointList&, const std::string&, size_t ){},
+                                        aggregator,
+                                        thread_pool );
+    auto population = ga.Run( "sector_2", sector.context, 10, std::make_shared<Exit_Condition>( 20, 0.001 ) );
+    ASSERT_GT( aggregator.Get_Timing_Count( "Delta Fitness Method Timing" ), 0 );
+
+    // Every score matches a full update of the same genome
+    for( const auto& member : population )
+    {
+        auto fresh = WaypointList( member.Get_DNA(),
+                                   member.Get_Number_Waypoint(),
+                                   sector.max_x,
+                                   sector.max_y,
+                                   sector.start_point,
+                                   sector.end_point );
+        fresh.Update_Fitness( *sector.context, false, aggregator );
+        ASSERT_EQ( member.Get_Fitness(), fresh.Get_Fitness() );
+    }
+}
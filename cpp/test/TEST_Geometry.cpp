@@ -6,17 +6,45 @@
 #include <gtest/gtest.h>
 
 // C++ Libraries
+#include <array>
+#include <cmath>
 #include <chrono>
+#include <map>
+#include <random>
 
 // Project Libraries
 #include "../src/Accumulator.hpp"
 #include "../src/DB_Utils.hpp"
+#include "../src/Distance_Kernels.hpp"
+#include "../src/Fitness_Engine.hpp"
 #include "../src/Geometry.hpp"
-#include "../src/QuadTree.hpp"
+#include "../src/Flat_QuadTree.hpp"
+#include "Utilities.hpp"
 
 // Boost Libraries
 #include <boost/log/trivial.hpp>
 
+/****************************************************************************/
+/*          Build the Segment Table for a Polyline (Reference Version)      */
+/****************************************************************************/
+static Segment_Table Build_Segment_Table( const std::vector<Point>& vertices )
+{
+    Segment_Table segments;
+    segments.Resize( vertices.size() - 1 );
+    for( size_t s=0; s<segments.Size(); s++ )
+    {
+        auto direction = vertices[s+1] - vertices[s];
+        segments.origin_x[s]    = vertices[s].x();
+        segments.origin_y[s]    = vertices[s].y();
+        segments.terminus_x[s]  = vertices[s+1].x();
+        segments.terminus_y[s]  = vertices[s+1].y();
+        segments.direction_x[s] = direction.x();
+        segments.direction_y[s] = direction.y();
+        segments.inv_length2[s] = direction.Mag() < 0.01 ? 0 : 1.0 / direction.Mag2();
+    }
+    return segments;
+}
+
 /****************************************************************************/
 /*          Run some simple checks on the Point/Line Distance Method        */
 /****************************************************************************/
@@ -57,6 +85,113 @@ TEST( Geometry, Point_Line_Distance)
     ASSERT_NEAR( Point_Line_Distance( p3, v1, v3 ), 4.52904, 0.001 );
 }
 
+/****************************************************************************/
+/*          Check the Vectorized Kernels against the Scalar Distance        */
+/****************************************************************************/
+TEST( Geometry, Nearest_Segment_Kernels )
+{
+    // Build a polyline with a degenerate segment in the middle
+    std::mt19937 rng( 42 );
+    std::uniform_real_distribution<double> dist( 0, 1000 );
+    std::vector<Point> vertices;
+    for( size_t i=0; i<12; i++ )
+    {
+        vertices.push_back( ToPoint2D( dist(rng), dist(rng) ) );
+    }
+    vertices[6] = vertices[5];
+
+    auto segments = Build_Segment_Table( vertices );
+
+    // Odd count so every kernel exercises its remainder loop
+    const size_t number_points = 1003;
+    std::vector<double> xs, ys;
+    for( size_t i=0; i<number_points; i++ )
+    {
+        xs.push_back( dist(rng) );
+        ys.push_back( dist(rng) );
+    }
+
+    // Scalar reference
+    std::vector<double>   ref_dist( number_points );
+    std::vector<uint32_t> ref_seg( number_points );
+    Nearest_Segment( Instruction_Set::SCALAR, xs.data(), ys.data(), number_points, segments, ref_dist.data(), ref_seg.data() );
+    for( size_t i=0; i<number_points; i++ )
+    {
+        double expected = std::numeric_limits<double>::max();
+        for( size_t s=0; s<segments.Size(); s++ )
+        {
+            expected = std::min( expected, Point_Line_Distance( ToPoint2D( xs[i], ys[i] ), vertices[s], vertices[s+1] ) );
+        }
+        ASSERT_NEAR( std::sqrt( ref_dist[i] ), expected, 0.001 );
+    }
+
+    // Every supported instruction set must match the scalar kernel exactly
+    for( auto isa : { Instruction_Set::SSE2, Instruction_Set::AVX2, Instruction_Set::AVX512 } )
+    {
+        if( !Is_Supported( isa ) )
+        {
+            BOOST_LOG_TRIVIAL(debug) << "Skipping unsupported instruction set: " << To_String( isa );
+            continue;
+        }
+        std::vector<double>   test_dist( number_points );
+        std::vector<uint32_t> test_seg( number_points );
+        Nearest_Segment( isa, xs.data(), ys.data(), number_points, segments, test_dist.data(), test_seg.data() );
+        for( size_t i=0; i<number_points; i++ )
+        {
+            ASSERT_EQ( test_dist[i], ref_dist[i] ) << To_String( isa ) << ", Point: " << i;
+            ASSERT_EQ( test_seg[i], ref_seg[i] ) << To_String( isa ) << ", Point: " << i;
+        }
+    }
+}
+
+/****************************************************************************/
+/*          Check the Culled Assignment against a Full Kernel Scan          */
+/****************************************************************************/
+TEST( Geometry, Fitness_Engine_Culling )
+{
+    // Points along a few noisy tracks, in track order like the database
+    std::mt19937 rng( 7 );
+    std::uniform_real_distribution<double> dist( 0, 1000 );
+    std::uniform_real_distribution<double> noise( -5, 5 );
+    std::vector<double> xs, ys;
+    for( size_t track=0; track<6; track++ )
+    {
+        auto start = ToPoint2D( dist(rng), dist(rng) );
+        auto end   = ToPoint2D( dist(rng), dist(rng) );
+        for( size_t i=0; i<501; i++ )
+        {
+            auto point = Point::LERP( start, end, i / 500.0 );
+            xs.push_back( point.x() + noise(rng) );
+            ys.push_back( point.y() + noise(rng) );
+        }
+    }
+
+    auto& engine = Fitness_Engine::Thread_Instance();
+    for( size_t number_vertices : { 4, 13, 20, 32 } )
+    {
+        std::vector<Point> vertices;
+        for( size_t i=0; i<number_vertices; i++ )
+        {
+            vertices.push_back( ToPoint2D( dist(rng), dist(rng) ) );
+        }
+        vertices[2] = vertices[1];
+
+        // Full scan over every segment
+        auto segments = Build_Segment_Table( vertices );
+        std::vector<double>   ref_dist( xs.size() );
+        std::vector<uint32_t> ref_seg( xs.size() );
+        Nearest_Segment( xs.data(), ys.data(), xs.size(), segments, ref_dist.data(), ref_seg.data() );
+
+        // Culling must not change a single assignment
+        engine.Assign( xs, ys, vertices );
+        for( size_t i=0; i<xs.size(); i++ )
+        {
+            ASSERT_EQ( engine.Get_Point_Distances2()[i], ref_dist[i] ) << "Vertices: " << number_vertices << ", Point: " << i;
+            ASSERT_EQ( engine.Get_Point_Segments()[i], ref_seg[i] ) << "Vertices: " << number_vertices << ", Point: " << i;
+        }
+    }
+}
+
 /********************************************************/
 /*          Test the Segment Density Function           */
 /********************************************************/
@@ -83,14 +218,14 @@ TEST( Geometry, Get_Segment_Density )
     // Create Quad Tree
     int max_objects = 20;
     int max_levels = 10;
-    QuadTree<QTNode> qt( bbox, 
-                         max_objects,
-                         max_levels );
+    Flat_QuadTree qt( bbox, 
+                      max_objects,
+                      max_levels );
 
     // Insert Points into QuadTree
     for( const auto& point : point_list )
     {
-        qt.Insert( std::make_shared<QTNode>( point.index, ToPoint2D( point.x_norm, point.y_norm ) ));
+        qt.Insert( point.index, ToPoint2D( point.x_norm, point.y_norm ) );
     }
 
     // Create an Accumulator
@@ -180,4 +315,129 @@ TEST( Geometry, Fitness_Score_01 )
 
     // Cleanup
     sqlite3_close(db);
-}
\ No newline at end of file
+}
+
+/****************************************************************************/
+/*          Score a Route the Original Way (std::map Over Every Point)      */
+/****************************************************************************/
+static std::array<double,3> Reference_Scores( const std::vector<Point>& point_list,
+                                              const std::vector<Point>& vertices,
+                                              std::vector<int>&         segment_counts )
+{
+    // Compute the closest segment for all points (First segment wins ties)
+    std::map<int,std::pair<size_t,double>> segment_point_mapping;
+    for( size_t point_id=0; point_id<point_list.size(); point_id++ )
+    {
+        segment_point_mapping[point_id].first = -1;
+        segment_point_mapping[point_id].second = -1;
+        for( size_t seg_idx=0; seg_idx<(vertices.size()-1); seg_idx++ )
+        {
+            auto dist = Point_Line_Distance( point_list[point_id],
+                                             vertices[seg_idx],
+                                             vertices[seg_idx+1] );
+            if( segment_point_mapping[point_id].second < 0 ||
+                dist < segment_point_mapping[point_id].second )
+            {
+                segment_point_mapping[point_id].first = seg_idx;
+                segment_point_mapping[point_id].second = dist;
+            }
+        }
+    }
+
+    // Per-segment reductions for each score
+    double total_route_len = 0;
+    double total_seg_ratio = 0;
+    double score_02 = 0;
+    double score_03 = 0;
+    segment_counts.assign( vertices.size() - 1, 0 );
+    for( size_t seg_idx=0; seg_idx < (vertices.size()-1); seg_idx++ )
+    {
+        double total_point_distance = 0;
+        int    num_points_in_segment = 0;
+        for( const auto& seg_pnt : segment_point_mapping )
+        {
+            if( seg_pnt.second.first == seg_idx )
+            {
+                total_point_distance += seg_pnt.second.second;
+                num_points_in_segment += 1;
+            }
+        }
+        segment_counts[seg_idx] = num_points_in_segment;
+
+        double segment_length = Point::Distance_L2( vertices[seg_idx],
+                                                    vertices[seg_idx+1] );
+        total_route_len += segment_length;
+        total_seg_ratio += std::pow( segment_length / (num_points_in_segment+1), 2 );
+        score_02 += std::pow( total_point_distance / (num_points_in_segment+1), 2 );
+        score_03 += total_point_distance;
+    }
+    return { (point_list.size() / total_route_len) * total_seg_ratio,
+             score_02,
+             score_03 * total_route_len };
+}
+
+/****************************************************************************/
+/*          Check the Engine Scores against the Original Implementation     */
+/****************************************************************************/
+static void Check_Engine_Scores( const std::vector<Point>& point_list,
+                                 const std::vector<Point>& vertices,
+                                 const std::string&        label )
+{
+    std::vector<int> counts;
+    auto expected = Reference_Scores( point_list, vertices, counts );
+
+    auto& engine = Fitness_Engine::Thread_Instance();
+    engine.Assign( point_list, vertices );
+    for( size_t seg_idx=0; seg_idx<counts.size(); seg_idx++ )
+    {
+        ASSERT_EQ( (int)engine.Get_Point_Count( seg_idx ), counts[seg_idx] ) << label << ", Segment: " << seg_idx;
+    }
+    ASSERT_NEAR( engine.Score( Fitness_Method::SCORE_01 ), expected[0], 1e-9 * std::fabs( expected[0] ) ) << label;
+    ASSERT_NEAR( engine.Score( Fitness_Method::SCORE_02 ), expected[1], 1e-9 * std::fabs( expected[1] ) ) << label;
+    ASSERT_NEAR( engine.Score( Fitness_Method::SCORE_03 ), expected[2], 1e-9 * std::fabs( expected[2] ) ) << label;
+}
+
+/*********************************************************************/
+/*          Test the Fitness Engine against the Original Scores      */
+/*********************************************************************/
+TEST( Geometry, Fitness_Engine_Reference )
+{
+    // Hand-built cases: points on shared vertices, before the start, past the end,
+    // on a degenerate segment and halfway between two parallel segments
+    std::vector<Point> vertices { ToPoint2D( 0, 0 ),
+                                  ToPoint2D( 10, 0 ),
+                                  ToPoint2D( 10, 10 ),
+                                  ToPoint2D( 10, 10 ),
+                                  ToPoint2D( 0, 10 ) };
+    std::vector<Point> point_list { ToPoint2D( 10, 0 ),
+                                    ToPoint2D( 10, 10 ),
+                                    ToPoint2D( 0, 0 ),
+                                    ToPoint2D( -3, -4 ),
+                                    ToPoint2D( -2, 12 ),
+                                    ToPoint2D( 13, 14 ),
+                                    ToPoint2D( 5, 5 ),
+                                    ToPoint2D( 15, 5 ),
+                                    ToPoint2D( 5, 7 ) };
+    Check_Engine_Scores( point_list, vertices, "Hand-Built" );
+
+    // Route that doubles back on itself, so every point ties between two segments
+    Check_Engine_Scores( point_list,
+                         { ToPoint2D( 0, 0 ), ToPoint2D( 10, 10 ), ToPoint2D( 0, 0 ) },
+                         "Doubled Back" );
+
+    // Random routes over sector_2
+    auto sector = Load_Test_Sector( "sector_2", ToPoint2D( 6, 2 ), ToPoint2D( 546, 1442 ) );
+    std::mt19937 rng( 11 );
+    std::uniform_real_distribution<double> dist_x( 0, sector.max_x );
+    std::uniform_real_distribution<double> dist_y( 0, sector.max_y );
+    for( size_t number_waypoints : { 1, 6, 15, 30 } )
+    {
+        std::vector<Point> route { sector.start_point };
+        for( size_t i=0; i<number_waypoints; i++ )
+        {
+            route.push_back( ToPoint2D( std::round( dist_x(rng) ), std::round( dist_y(rng) ) ) );
+        }
+        route.push_back( sector.end_point );
+        Check_Engine_Scores( sector.context->geo_point_list, route, "Sector 2, Waypoints: " + std::to_string( number_waypoints ) );
+    }
+}
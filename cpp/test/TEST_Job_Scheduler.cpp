@@ -0,0 +1,105 @@
+/**
+ * @file    TEST_Job_Scheduler.cpp
+ * @author  Marvin Smith
+ * @date    1/12/2021
+ */
+#include <gtest/gtest.h>
+
+// C++ Libraries
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+// Project Libraries
+#include "../src/Job_Scheduler.hpp"
+
+/*****************************************************************/
+/*          Test Chained Jobs with Nested Parallel Loops         */
+/*****************************************************************/
+TEST( Job_Scheduler, Chained_Jobs )
+{
+    // More chains than workers, and every job blocks on its own parallel_for
+    Job_Scheduler scheduler( 2 );
+    const size_t number_chains = 6;
+    const size_t chain_length  = 5;
+    std::vector<std::atomic_size_t> totals( number_chains );
+
+    std::function<void(size_t,size_t)> run_link = [&]( size_t chain, size_t link )
+    {
+        scheduler.Get_Thread_Pool().parallel_for( 0, 1000, 0, [&]( size_t idx ){ totals[chain] += idx; } );
+        if( link + 1 < chain_length )
+        {
+            scheduler.Submit( "Chain", [&run_link, chain, link](){ run_link( chain, link + 1 ); } );
+        }
+    };
+    for( size_t chain = 0; chain < number_chains; chain++ )
+    {
+        scheduler.Submit( "Chain", [&run_link, chain](){ run_link( chain, 0 ); } );
+    }
+    scheduler.Wait_All();
+
+    for( size_t chain = 0; chain < number_chains; chain++ )
+    {
+        ASSERT_EQ( totals[chain], chain_length * 499500 );
+    }
+}
+
+/*****************************************************/
+/*          Test Job Exception Propagation           */
+/*****************************************************/
+TEST( Job_Scheduler, Job_Exception )
+{
+    // One worker, held busy until every job is queued
+    Job_Scheduler scheduler( 1 );
+    std::mutex gate_mtx;
+    gate_mtx.lock();
+    scheduler.Submit( "Gate", [&](){ std::lock_guard<std::mutex> lck( gate_mtx ); } );
+
+    std::atomic_int finished = 0;
+    scheduler.Submit( "Bad Job", [](){ throw std::runtime_error( "Bad Job" ); }, 1 );
+    for( int i = 0; i < 4; i++ )
+    {
+        scheduler.Submit( "Good Job", [&](){ finished++; } );
+    }
+    gate_mtx.unlock();
+
+    // The failure is reported and the jobs queued behind it never start
+    ASSERT_THROW( scheduler.Wait_All(), std::runtime_error );
+    ASSERT_EQ( finished, 0 );
+
+    // Exceptions not derived from std::exception are reported too
+    scheduler.Submit( "Bad Job", [](){ throw 5; } );
+    ASSERT_THROW( scheduler.Wait_All(), int );
+
+    // The scheduler is still usable
+    scheduler.Submit( "Good Job", [&](){ finished++; } );
+    scheduler.Wait_All();
+    ASSERT_EQ( finished, 1 );
+}
+
+/*************************************************************/
+/*          Test Highest Priority Jobs Start First           */
+/*************************************************************/
+TEST( Job_Scheduler, Priority_Order )
+{
+    // One worker, held busy until every job is queued
+    Job_Scheduler scheduler( 1 );
+    std::mutex gate_mtx;
+    gate_mtx.lock();
+    scheduler.Submit( "Gate", [&](){ std::lock_guard<std::mutex> lck( gate_mtx ); } );
+
+    std::vector<int> order;
+    std::vector<double> priorities { 2, 7, 1, 7, 5 };
+    for( size_t i = 0; i < priorities.size(); i++ )
+    {
+        scheduler.Submit( "Job", [&order, i](){ order.push_back( (int)i ); }, priorities[i] );
+    }
+    gate_mtx.unlock();
+    scheduler.Wait_All();
+
+    // Ties keep submission order
+    std::vector<int> expected { 1, 3, 4, 0, 2 };
+    ASSERT_EQ( order, expected );
+}
@@ -0,0 +1,53 @@
+/**
+ * @file    TEST_Random.cpp
+ * @author  Marvin Smith
+ * @date    1/16/2021
+ */
+#include <gtest/gtest.h>
+
+// C++ Libraries
+#include <vector>
+
+// Project Libraries
+#include "../src/Random.hpp"
+
+/*************************************************/
+/*          Test the Random Generator            */
+/*************************************************/
+TEST( Random_Generator, Uniform )
+{
+    // Same seed and stream, same sequence
+    Random_Generator rng1( 1234, 5 );
+    Random_Generator rng2( 1234, 5 );
+    for( int i=0; i<100; i++ )
+    {
+        ASSERT_EQ( rng1.Next(), rng2.Next() );
+    }
+
+    // Neighboring streams do not line up
+    Random_Generator rng3( 1234, 6 );
+    size_t matches = 0;
+    for( int i=0; i<100; i++ )
+    {
+        matches += ( rng1.Next() == rng3.Next() );
+    }
+    ASSERT_EQ( matches, 0 );
+
+    // Values stay in range and every bucket gets hit
+    std::vector<size_t> counts( 10, 0 );
+    for( int i=0; i<10000; i++ )
+    {
+        auto value = rng1.Uniform( counts.size() );
+        ASSERT_LT( value, counts.size() );
+        counts[value]++;
+
+        auto real = rng1.Uniform_Real();
+        ASSERT_GE( real, 0 );
+        ASSERT_LT( real, 1 );
+    }
+    for( auto count : counts )
+    {
+        ASSERT_GT( count, 800 );
+        ASSERT_LT( count, 1200 );
+    }
+}
@@ -11,7 +11,9 @@
 #include <boost/log/trivial.hpp>
 
 // C++ Libraries
+#include <atomic>
 #include <chrono>
+#include <stdexcept>
 
 TEST( Thread_Pool, Simple_Example )
 {
@@ -32,4 +34,50 @@ TEST( Thread_Pool, Simple_Example )
     auto end = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
     BOOST_LOG_TRIVIAL(debug) << "Thread_Pool duration = " << duration.count() / 1000.f << " s";
-}
\ No newline at end of file
+}
+
+TEST( Thread_Pool, Run_Batch )
+{
+    // The same pool must be reusable for many batches without being destroyed
+    Thread_Pool tp( 4 );
+    std::vector<int> hits( 1000 );
+    for( int batch = 0; batch < 50; batch++ )
+    {
+        tp.run_batch( hits.size(), [&]( size_t idx ){ hits[idx]++; } );
+        for( size_t i = 0; i < hits.size(); i++ )
+        {
+            ASSERT_EQ( hits[i], batch + 1 );
+        }
+    }
+
+    // Empty batches return right away
+    tp.run_batch( 0, []( size_t ){ FAIL(); } );
+}
+
+TEST( Thread_Pool, Parallel_For )
+{
+    Thread_Pool tp( 4 );
+
+    // Every index in the range runs exactly once, for any grain size
+    for( size_t grain : { 0, 1, 7, 64, 5000 } )
+    {
+        std::vector<std::atomic_int> hits( 2003 );
+        tp.parallel_for( 10, hits.size(), grain, [&]( size_t idx ){ hits[idx]++; } );
+        for( size_t i = 0; i < hits.size(); i++ )
+        {
+            ASSERT_EQ( hits[i], ( i < 10 ) ? 0 : 1 ) << "Grain: " << grain << ", Index: " << i;
+        }
+    }
+
+    // Exceptions come back to the caller and the pool stays usable
+    ASSERT_THROW( tp.parallel_for( 0, 1000, 10, []( size_t idx ){
+                      if( idx == 517 )
+                      {
+                          throw std::runtime_error( "Bad Index" );
+                      }
+                  }), std::runtime_error );
+
+    std::atomic_size_t total = 0;
+    tp.parallel_for( 0, 100, 0, [&]( size_t idx ){ total += idx; } );
+    ASSERT_EQ( total, 4950 );
+}
@@ -25,17 +25,197 @@
 /*************************************************************/
 TEST( WaypointList, Create_Random )
 {
+    Random_Generator rng( 0 );
     auto wp1 = WaypointList::Create_Random( 10, 867, 2326, 
                                             ToPoint2D(0,0), 
-                                            ToPoint2D(867, 2326) );
+                                            ToPoint2D(867, 2326),
+                                            rng );
     ASSERT_EQ( wp1.Get_DNA().size(), 10 * 7 );
 }
 
+/*********************************************************/
+/*          Test the Packed Genome Operators             */
+/*********************************************************/
+TEST( WaypointList, Packed_Genome )
+{
+    const size_t max_x = 867;
+    const size_t max_y = 2326;
+    const std::string dna = "0821029021903430015092402001517010008700195058601241099029719860700234208";
+    auto wp1 = WaypointList( dna, 10, max_x, max_y,
+                             ToPoint2D(0,0), 
+                             ToPoint2D(867, 2326) );
+
+    // The DNA string is just a view of the genome.  Digits past the range (9034 and 8601) clamp to it.
+    ASSERT_EQ( wp1.Get_DNA(), "0821029021232530015092402001517010008700195052325241099029719860700234" );
+    ASSERT_EQ( wp1.Get_Genome().size(), 20 );
+    ASSERT_EQ( wp1.Get_Genome()[0], 82 );
+    ASSERT_EQ( wp1.Get_Genome()[1], 1029 );
+    auto verts = wp1.Get_Vertices( true );
+    ASSERT_EQ( verts.size(), 10 );
+    ASSERT_EQ( verts[1].x(), 21 );
+    ASSERT_EQ( verts[1].y(), max_y - 1 );
+    ASSERT_EQ( verts[6].y(), max_y - 1 );
+
+    // Ranges the 16-bit coordinates cannot hold are rejected
+    ASSERT_THROW( WaypointList( dna, 10, 70000, max_y, ToPoint2D(0,0), ToPoint2D(867, 2326) ), std::runtime_error );
+    ASSERT_THROW( WaypointList( dna, 10, max_x, 0, ToPoint2D(0,0), ToPoint2D(867, 2326) ), std::runtime_error );
+    auto wp_full = WaypointList( std::vector<Point>{ ToPoint2D( 70000, 65535 ) }, max_x, WaypointList::MAX_RANGE,
+                                 ToPoint2D(0,0), ToPoint2D(867, 2326) );
+    ASSERT_EQ( wp_full.Get_Genome()[0], max_x - 1 );
+    ASSERT_EQ( wp_full.Get_Genome()[1], 65535 );
+
+    Random_Generator rng( 0 );
+    for( int i=0; i<200; i++ )
+    {
+        // Mutation only ever touches a single coordinate and stays in range
+        auto wp2 = WaypointList::Create_Random( 10, max_x, max_y, ToPoint2D(0,0), ToPoint2D(867, 2326), rng );
+        auto wp3 = wp2;
+        WaypointList::Mutation( wp3, rng );
+        size_t changed = 0;
+        for( size_t c=0; c<wp2.Get_Genome().size(); c++ )
+        {
+            changed += ( wp2.Get_Genome()[c] != wp3.Get_Genome()[c] );
+            ASSERT_LT( wp3.Get_Genome()[c], ( c % 2 == 0 ) ? max_x : max_y );
+        }
+        ASSERT_LE( changed, 1 );
+
+        // Crossing a genome with itself gives it back
+        ASSERT_EQ( WaypointList::Crossover( wp2, wp2, rng ), wp2 );
+
+        // Children take a prefix from the first parent and a suffix from the second
+        auto child = WaypointList::Crossover( wp2, wp3, rng );
+        ASSERT_EQ( child.Get_Fitness(), -1 );
+        for( size_t c=0; c<child.Get_Genome().size(); c++ )
+        {
+            ASSERT_LT( child.Get_Genome()[c], ( c % 2 == 0 ) ? max_x : max_y );
+        }
+
+        // Writing the child in place gives the same genome, even over one of the parents
+        Random_Generator rng1( i );
+        auto expected = WaypointList::Crossover( wp2, wp3, rng1 );
+        Random_Generator rng2( i );
+        auto in_place = wp3;
+        in_place.Set_Fitness( 1 );
+        WaypointList::Crossover_Into( wp2, in_place, in_place, rng2 );
+        ASSERT_EQ( in_place, expected );
+        ASSERT_TRUE( in_place.Is_Dirty() );
+    }
+}
+
+/*********************************************************/
+/*          Test the Genome Hash                         */
+/*********************************************************/
+TEST( WaypointList, Genome_Hash )
+{
+    const size_t max_x = 867;
+    const size_t max_y = 2326;
+    Random_Generator rng( 0 );
+    auto wp = WaypointList::Create_Random( 10, max_x, max_y, ToPoint2D(0,0), ToPoint2D(867, 2326), rng );
+    auto other = WaypointList::Create_Random( 10, max_x, max_y, ToPoint2D(0,0), ToPoint2D(867, 2326), rng );
+    for( int i=0; i<200; i++ )
+    {
+        // Whatever the operators did, the hash matches a genome built from scratch
+        if( i % 2 == 0 )
+        {
+            WaypointList::Mutation( wp, rng );
+        }
+        else
+        {
+            wp = WaypointList::Crossover( wp, other, rng );
+        }
+        auto rebuilt = WaypointList( wp.Get_DNA(), 10, max_x, max_y, ToPoint2D(0,0), ToPoint2D(867, 2326) );
+        ASSERT_EQ( wp.Get_Hash(), rebuilt.Get_Hash() );
+        ASSERT_EQ( wp, rebuilt );
+
+        // Different genomes get different hashes
+        ASSERT_EQ( wp.Get_Hash() == other.Get_Hash(), wp.Get_DNA() == other.Get_DNA() );
+    }
+
+    // Shuffling the waypoints moves coordinates to new positions
+    auto shuffled = wp;
+    shuffled.Randomize_Vertices( wp, rng );
+    auto rebuilt = WaypointList( shuffled.Get_DNA(), 10, max_x, max_y, ToPoint2D(0,0), ToPoint2D(867, 2326) );
+    ASSERT_EQ( shuffled.Get_Hash(), rebuilt.Get_Hash() );
+}
+
+/*********************************************************/
+/*          Test the Dirty Flag                          */
+/*********************************************************/
+TEST( WaypointList, Dirty_Flag )
+{
+    Random_Generator rng( 0 );
+    auto wp = WaypointList::Create_Random( 10, 867, 2326, ToPoint2D(1,2), ToPoint2D(866, 2325), rng );
+    ASSERT_TRUE( wp.Is_Dirty() );
+    wp.Set_Fitness( 10 );
+    ASSERT_FALSE( wp.Is_Dirty() );
+
+    // Copies are not re-scored
+    auto copy = wp;
+    ASSERT_FALSE( copy.Is_Dirty() );
+
+    // Every genetic operator marks its output dirty
+    WaypointList::Mutation( copy, rng );
+    ASSERT_TRUE( copy.Is_Dirty() );
+    ASSERT_TRUE( WaypointList::Crossover( wp, wp, rng ).Is_Dirty() );
+    copy = wp;
+    WaypointList::Randomize( copy, rng );
+    ASSERT_TRUE( copy.Is_Dirty() );
+    copy = wp;
+    copy.Randomize_Vertices( wp, rng );
+    ASSERT_TRUE( copy.Is_Dirty() );
+}
+
+/*********************************************************/
+/*          Test the Decoded Vertex List                 */
+/*********************************************************/
+TEST( WaypointList, Decoded_Vertices )
+{
+    Random_Generator rng( 0 );
+    auto wp    = WaypointList::Create_Random( 10, 867, 2326, ToPoint2D(1,2), ToPoint2D(866, 2325), rng );
+    auto other = WaypointList::Create_Random( 10, 867, 2326, ToPoint2D(1,2), ToPoint2D(866, 2325), rng );
+
+    // Reading the vertices does not decode them again
+    const Point* cached = wp.Get_Vertices().data();
+    ASSERT_EQ( wp.Get_Vertices().data(), cached );
+    ASSERT_EQ( wp.Get_Vertices( true ).data(), cached + 1 );
+
+    // The vertices follow every operation that changes the genome
+    for( int i=0; i<100; i++ )
+    {
+        switch( i % 4 )
+        {
+            case 0: WaypointList::Mutation( wp, rng ); break;
+            case 1: WaypointList::Randomize( wp, rng ); break;
+            case 2: wp.Randomize_Vertices( wp, rng ); break;
+            case 3: WaypointList::Crossover_Into( other, wp, wp, rng ); break;
+        }
+
+        auto verts = wp.Get_Vertices();
+        ASSERT_EQ( verts.size(), 12 );
+        ASSERT_EQ( verts.front().x(), 1 );
+        ASSERT_EQ( verts.back().y(), 2325 );
+        for( size_t v=0; v<10; v++ )
+        {
+            ASSERT_EQ( verts[v+1].x(), wp.Get_Genome()[2*v] );
+            ASSERT_EQ( verts[v+1].y(), wp.Get_Genome()[2*v+1] );
+        }
+        auto waypoints = wp.Get_Vertices( true );
+        ASSERT_EQ( waypoints.size(), 10 );
+        ASSERT_EQ( waypoints.data(), verts.data() + 1 );
+    }
+
+    // Copies carry their own vertices
+    auto copy = wp;
+    ASSERT_NE( copy.Get_Vertices().data(), wp.Get_Vertices().data() );
+    ASSERT_EQ( copy.Get_Vertices()[5].x(), wp.Get_Vertices()[5].x() );
+}
+
 /****************************************************************/
 /*          Test the Waypoint Randomize Vector Method           */
 /****************************************************************/
 TEST( WaypointList, Randomize_Vertices )
 {
+    Random_Generator rng( 0 );
     auto wp1 = WaypointList( "08210299021903430015092402001517010008700195058601241099029719860700234208460033", 
                              10, 867, 2326, 
                              ToPoint2D(0,0), 
@@ -46,7 +226,7 @@ TEST( WaypointList, Randomize_Vertices )
 
     for( int i=0; i<5; i++ )
     {
-        wp2.Randomize_Vertices( wp2 );
+        wp2.Randomize_Vertices( wp2, rng );
         //BOOST_LOG_TRIVIAL(debug) << "Post-Randomize: " << wp2.To_String(true);
     }
 }
@@ -56,6 +236,7 @@ TEST( WaypointList, Randomize_Vertices )
 /*********************************************************/
 TEST( WaypointList, Randomize )
 {
+    Random_Generator rng( 0 );
     auto wp1 = WaypointList( "08210299021903430015092402001517010008700195058601241099029719860700234208460033", 
                              10, 867, 2326, 
                              ToPoint2D(0,0), 
@@ -66,7 +247,7 @@ TEST( WaypointList, Randomize )
 
     for( int i=0; i<5; i++ )
     {
-        WaypointList::Randomize( wp2 );
+        WaypointList::Randomize( wp2, rng );
         BOOST_LOG_TRIVIAL(debug) << "Post-Randomize: " << wp2.To_String(true);
     }
 }
@@ -113,14 +294,9 @@ TEST( WaypointList, Update_Fitness )
                              << "], Max: [" << std::get<2>(range) << ", " << std::get<3>(range) << "]";
 
     // Create Context Object
-    Context context;
-    context.point_list = point_list;
-    context.start_point = start_point;
-    context.end_point   = end_point;
-    for( const auto& pt : context.point_list )
-    {
-        context.geo_point_list.push_back( ToPoint2D( pt.x_norm, pt.y_norm ) );
-    }
+    auto context = Context::Create( point_list,
+                                    start_point,
+                                    end_point );
 
     // Load the unit-test fitness data
     auto fitness_samples = Load_CSV_Fitness_Samples( coord_path );
@@ -135,7 +311,7 @@ TEST( WaypointList, Update_Fitness )
                                 start_point,
                                 end_point );
 
-    ref_wp.Update_Fitness( &context, 
+    ref_wp.Update_Fitness( *context, 
                            false,
                            aggregator );
     BOOST_LOG_TRIVIAL(debug) << "Reference Waypoint: " << ref_wp.To_String(true);
@@ -153,7 +329,7 @@ TEST( WaypointList, Update_Fitness )
                                 end_point );
         
         // Compute Fitness Update
-        wp.Update_Fitness( &context, 
+        wp.Update_Fitness( *context, 
                            false,
                            aggregator );
         
@@ -165,6 +341,118 @@ TEST( WaypointList, Update_Fitness )
     sqlite3_close(db);
 }
 
+/************************************************************************/
+/*          Test the WaypointList Incremental Fitness Update            */
+/************************************************************************/
+TEST( WaypointList, Delta_Fitness )
+{
+    auto sector = Load_Test_Sector( "sector_2",
+                                    ToPoint2D( 5.707200, 1.696290 ),
+                                    ToPoint2D( 545.149380, 1441.971723 ) );
+
+    Stats_Aggregator aggregator( "junk_path" );
+    Random_Generator rng( 0 );
+    auto check_fitness = [&]( const WaypointList& wp )
+    {
+        auto fresh_wp = WaypointList( wp.Get_DNA(),
+                                      wp.Get_Number_Waypoint(),
+                                      sector.max_x,
+                                      sector.max_y,
+                                      sector.start_point,
+                                      sector.end_point );
+        fresh_wp.Update_Fitness( *sector.context, false, aggregator );
+        ASSERT_EQ( wp.Get_Fitness(), fresh_wp.Get_Fitness() );
+    };
+
+    for( size_t trial=0; trial<20; trial++ )
+    {
+        // Long enough for a few moved waypoints to stay incremental
+        WaypointList::Fitness_State state;
+        auto wp = WaypointList::Create_Random( 30, sector.max_x, sector.max_y, sector.start_point, sector.end_point, rng );
+        wp.Update_Fitness( *sector.context, wp, state, aggregator );
+        check_fitness( wp );
+
+        // Mutate one or more waypoints, then make sure the incremental score matches a fresh one
+        for( size_t step=0; step<10; step++ )
+        {
+            auto relative = wp;
+            for( size_t m=0; m<=(step % 3); m++ )
+            {
+                WaypointList::Mutation( wp, rng );
+            }
+            wp.Update_Fitness( *sector.context, relative, state, aggregator );
+            check_fitness( wp );
+        }
+
+        // A child starts from the assignment of a parent
+        auto other = WaypointList::Create_Random( 30, sector.max_x, sector.max_y, sector.start_point, sector.end_point, rng );
+        auto child = wp;
+        WaypointList::Crossover_Into( wp, other, child, rng );
+        ASSERT_LE( child.Count_Moved_Waypoints( wp ), 30 );
+        auto child_state = state;
+        child.Update_Fitness( *sector.context, wp, child_state, aggregator );
+        check_fitness( child );
+
+        // A state that belongs to another genome is not used
+        auto stale_state = state;
+        other.Update_Fitness( *sector.context, other, stale_state, aggregator );
+        check_fitness( other );
+        other.Update_Fitness( *sector.context, wp, stale_state, aggregator );
+        check_fitness( other );
+    }
+    ASSERT_GT( aggregator.Get_Timing_Count( "Delta Fitness Method Timing" ), 0 );
+}
+
+/********************************************************************/
+/*          Test the WaypointList Lift-Population Method            */
+/********************************************************************/
+TEST( WaypointList, Lift_Population )
+{
+    auto sector = Load_Test_Sector( "sector_2", ToPoint2D( 6, 2 ), ToPoint2D( 546, 1442 ) );
+
+    // Even coordinates keep every midpoint on the genome grid
+    Stats_Aggregator aggregator( "junk_path" );
+    Random_Generator rng( 0 );
+    std::vector<WaypointList> population;
+    for( size_t i=0; i<10; i++ )
+    {
+        auto temp_wp = WaypointList::Create_Random( 8, sector.max_x / 2, sector.max_y / 2, sector.start_point, sector.end_point, rng );
+        std::vector<Point> waypoints;
+        for( const auto& vertex : temp_wp.Get_Vertices( true ) )
+        {
+            waypoints.push_back( vertex * 2 );
+        }
+        population.emplace_back( waypoints, sector.max_x, sector.max_y, sector.start_point, sector.end_point );
+        population.back().Update_Fitness( *sector.context, false, aggregator );
+    }
+
+    auto lifted = Lift_Population( population, *sector.context );
+    ASSERT_EQ( lifted.size(), population.size() );
+    for( size_t i=0; i<lifted.size(); i++ )
+    {
+        ASSERT_EQ( lifted[i].Get_Number_Waypoint(), 9 );
+
+        // Every original waypoint survives, in order
+        auto old_vertices = population[i].Get_Vertices();
+        auto new_vertices = lifted[i].Get_Vertices();
+        size_t matched = 0;
+        for( const auto& vertex : new_vertices )
+        {
+            if( matched < old_vertices.size() &&
+                vertex.x() == old_vertices[matched].x() &&
+                vertex.y() == old_vertices[matched].y() )
+            {
+                matched++;
+            }
+        }
+        ASSERT_EQ( matched, old_vertices.size() );
+
+        // Same route, so the same score
+        lifted[i].Update_Fitness( *sector.context, false, aggregator );
+        ASSERT_NEAR( lifted[i].Get_Fitness(), population[i].Get_Fitness(), 1e-6 * population[i].Get_Fitness() );
+    }
+}
+
 /********************************************************************/
 /*          Test the WaypointList Seed-Population Method            */
 /********************************************************************/
@@ -206,14 +494,9 @@ TEST( WaypointList, Seed_Population )
                              << "], Max: [" << std::get<2>(range) << ", " << std::get<3>(range) << "]";
 
     // Create Context Object
-    Context context;
-    context.point_list = point_list;
-    context.start_point = start_point;
-    context.end_point   = end_point;
-    for( const auto& pt : context.point_list )
-    {
-        context.geo_point_list.push_back( ToPoint2D( pt.x_norm, pt.y_norm ) );
-    }
+    auto context = Context::Create( point_list,
+                                    start_point,
+                                    end_point );
 
     // Create the seeded population
     auto seed_db_point_list = Load_Point_List( db, sector_id, dataset_id );
@@ -226,6 +509,7 @@ TEST( WaypointList, Seed_Population )
         seed_point_list.push_back( ToPoint2D( pt.x_norm, pt.y_norm ) );
     }
 
+    Random_Generator rng( 0 );
     auto seeded_population = Seed_Population( seed_point_list,
                                               min_waypoints,
                                               max_waypoints,
@@ -233,7 +517,8 @@ TEST( WaypointList, Seed_Population )
                                               max_x,
                                               max_y,
                                               start_point,
-                                              end_point );
+                                              end_point,
+                                              rng );
 
     ASSERT_EQ( seeded_population.size(), max_waypoints - min_waypoints + 1 );
     for( size_t i=min_waypoints; i<= max_waypoints; i++ )
@@ -258,7 +543,7 @@ TEST( WaypointList, Seed_Population )
         {
             for( auto& p : pr.second )
             {
-                p.Update_Fitness( &context, false, aggregator );
+                p.Update_Fitness( *context, false, aggregator );
             }
             writer_obj->Write( pr.second.front(), 
                                "sector_" + std::to_string(sector), 
@@ -7,11 +7,14 @@
 
 // Boost Libraries
 #include <boost/algorithm/string.hpp>
+#include <boost/log/trivial.hpp>
 
 // C++ Libraries
 #include <fstream>
+#include <stdexcept>
 
 // Project Libraries
+#include "../src/DB_Utils.hpp"
 #include "../src/GDAL_Utilities.hpp"
 
 /****************************************/
@@ -86,4 +89,41 @@ std::vector<std::tuple<std::string,std::string,int>> Load_CSV_Fitness_Samples( c
     fin.close();
 
     return output;
-}
\ No newline at end of file
+}
+
+/************************************************/
+/*          Load a Unit-Test Sector             */
+/************************************************/
+Test_Sector Load_Test_Sector( const std::string& sector_id,
+                              const Point&       start_point,
+                              const Point&       end_point )
+{
+    // Path to Unit-Test Data
+    std::filesystem::path db_path( "cpp/unit_test_data/bike_data.db" );
+    if( !std::filesystem::is_regular_file( db_path ) )
+    {
+        BOOST_LOG_TRIVIAL(error) << "Test Database Path Does Not Exist: " << db_path;
+        throw std::runtime_error( "Test Database Path Does Not Exist: " + db_path.string() );
+    }
+
+    // Load the database
+    sqlite3 *db;
+    if( sqlite3_open( db_path.c_str(), &db ) != SQLITE_OK )
+    {
+        sqlite3_close( db );
+        throw std::runtime_error( "Unable to open the test database: " + db_path.string() );
+    }
+    auto point_list = Load_Point_List( db, sector_id );
+    sqlite3_close( db );
+
+    Test_Sector sector;
+    auto range = Normalize_Points( point_list );
+    sector.max_x = std::get<2>(range) - std::get<0>(range) + 1;
+    sector.max_y = std::get<3>(range) - std::get<1>(range) + 1;
+    sector.start_point = start_point;
+    sector.end_point   = end_point;
+    sector.context = Context::Create( point_list,
+                                      start_point,
+                                      end_point );
+    return sector;
+}
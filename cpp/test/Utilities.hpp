@@ -12,8 +12,37 @@
 #include <vector>
 
 // Project Libraries
+#include "../src/Context.hpp"
 #include "../src/Point.hpp"
 
+/**
+ * @brief Normalized sector data loaded from the unit-test database
+ */
+struct Test_Sector
+{
+    /// Fitness Context
+    Context::ptr_t context;
+
+    /// Genome range
+    size_t max_x;
+    size_t max_y;
+
+    /// Normalized endpoints
+    Point start_point;
+    Point end_point;
+};
+
+/**
+ * @brief Load a sector from cpp/unit_test_data/bike_data.db and build its Context
+ * @param sector_id Sector table name
+ * @param start_point Normalized starting coordinate
+ * @param end_point Normalized ending coordinate
+ * @throws std::runtime_error if the database is missing
+ */
+Test_Sector Load_Test_Sector( const std::string& sector_id,
+                              const Point&       start_point,
+                              const Point&       end_point );
+
 /**
  * @brief Load the CSV Vertices
  */
@@ -23,4 +52,4 @@ std::vector<Point> Load_CSV_Vertices( const std::filesystem::path& coord_path,
 /**
  * @brief Load the CSV Sector 2 Fitness Samples
  */
-std::vector<std::tuple<std::string,std::string,int>> Load_CSV_Fitness_Samples( const std::filesystem::path& coord_path );
\ No newline at end of file
+std::vector<std::tuple<std::string,std::string,int>> Load_CSV_Fitness_Samples( const std::filesystem::path& coord_path );